@@ -0,0 +1,174 @@
+"""
+Benchmarks of lds-gen for airspeed velocity (asv)
+
+Every `time_*` benchmark generates `N` points (or values), so points per second are
+`N` divided by the reported time. The `track_bytes_per_point` benchmarks report the
+memory allocated per point of a batch, as measured by `tracemalloc`, and the
+`peakmem_*` benchmarks the peak resident memory of the process.
+
+The `kernels` parameter runs the batch paths with the compiled kernels ("native")
+and with them disabled ("python"); benchmarks needing "native" are skipped when
+the extension is not built.
+
+Run them with:
+
+    asv run             # benchmark the latest commit of the main branch
+    asv continuous main HEAD   # compare a branch against main
+    asv compare v0.1 v0.2      # compare two releases
+"""
+
+import tracemalloc
+from array import array
+
+from lds_gen import ilds, kronecker, lds, product, sobol, sphere_n
+from lds_gen.lds import PRIME_TABLE
+from lds_gen.parallel import generate_parallel
+
+N = 10000
+KERNELS = ["native", "python"]
+# The smallest, a small and the largest tabulated prime base
+BASES = [2, 3, PRIME_TABLE[-1]]
+DIMS = [2, 10, 100, 1000]
+
+GENERATORS = {
+    "lds.VdCorput": lambda: lds.VdCorput(3),
+    "lds.IncrementalVdCorput": lambda: lds.IncrementalVdCorput(3),
+    "lds.Halton": lambda: lds.Halton([2, 3]),
+    "lds.Circle": lambda: lds.Circle(2),
+    "lds.Circle[table]": lambda: lds.Circle(2, trig="table"),
+    "lds.Sphere": lambda: lds.Sphere([2, 3]),
+    "lds.Sphere[table]": lambda: lds.Sphere([2, 3], trig="table"),
+    "lds.Sphere3Hopf": lambda: lds.Sphere3Hopf([2, 3, 5]),
+    "lds.Sphere3Hopf[table]": lambda: lds.Sphere3Hopf([2, 3, 5], trig="table"),
+    "lds.HaltonN": lambda: lds.HaltonN(3, [2, 3, 5]),
+    "sobol.Sobol": lambda: sobol.Sobol(3),
+    "sphere_n.SphereN": lambda: sphere_n.SphereN([2, 3, 5, 7, 11]),
+    "kronecker.Kronecker": lambda: kronecker.Kronecker(3),
+    "product.Product": lambda: product.Product.auto(
+        [(lds.HaltonN, 3), lds.Sphere, lds.Circle]
+    ),
+    "ilds.VdCorput": lambda: ilds.VdCorput(3, 20),
+    "ilds.IncrementalVdCorput": lambda: ilds.IncrementalVdCorput(3, 20),
+    "ilds.Halton": lambda: ilds.Halton([2, 3], [11, 7]),
+}
+
+
+class _Kernels:
+    """Select the compiled or the pure-Python batch kernels in `setup()`"""
+
+    def setup(self, *params):
+        self._saved = lds._native, ilds._native, sphere_n._native, kronecker._native
+        if params[-1] == "python":
+            lds._native = ilds._native = sphere_n._native = kronecker._native = None
+        elif lds._native is None:
+            raise NotImplementedError("compiled kernels are not available")
+
+    def teardown(self, *params):
+        lds._native, ilds._native, sphere_n._native, kronecker._native = self._saved
+
+
+def bytes_per_point(fn, n):
+    """Memory allocated by `fn()` (including its result), per point"""
+    tracemalloc.start()
+    try:
+        res = fn()
+        size = tracemalloc.get_traced_memory()[1]
+    finally:
+        tracemalloc.stop()
+    del res
+    return size / n
+
+
+class Scalar:
+    params = BASES
+    param_names = ["base"]
+
+    def time_vdc(self, base):
+        vdc = lds.vdc
+        for k in range(N):
+            vdc(k, base)
+
+    def time_vdc_i(self, base):
+        vdc_i = ilds.vdc_i
+        for k in range(N):
+            vdc_i(k, base, 10)
+
+
+class VdcBatch(_Kernels):
+    params = (BASES, KERNELS)
+    param_names = ["base", "kernels"]
+
+    def time_vdc_batch(self, base, kernels):
+        lds.vdc_batch(range(N), base)
+
+    def time_vdc_batch_strided(self, base, kernels):
+        lds.vdc_batch(range(0, 7 * N, 7), base)
+
+
+class Generators(_Kernels):
+    params = (list(GENERATORS), KERNELS)
+    param_names = ["generator", "kernels"]
+
+    def setup(self, name, kernels):
+        super().setup(name, kernels)
+        self.gen = GENERATORS[name]()
+        typecode = getattr(self.gen, "typecode", "d")
+        self.out = array(typecode, bytes(array(typecode).itemsize * N * self.gen.dim))
+        self.gen.slice(0, N)  # build the lookup tables outside of the timings
+
+    def time_pop(self, name, kernels):
+        pop = self.gen.pop
+        for _ in range(N):
+            pop()
+
+    def time_fill(self, name, kernels):
+        self.gen.fill(self.out)
+
+    def time_slice(self, name, kernels):
+        self.gen.slice(10**9, 10**9 + N)
+
+    def track_bytes_per_point(self, name, kernels):
+        return bytes_per_point(lambda: self.gen.slice(0, N), N)
+
+    track_bytes_per_point.unit = "bytes"
+
+    def peakmem_slice(self, name, kernels):
+        self.gen.slice(0, N)
+
+
+class HaltonNDims(_Kernels):
+    """HaltonN with the first `dim` primes, up to the 1000th prime"""
+
+    params = (DIMS, KERNELS)
+    param_names = ["dim", "kernels"]
+
+    def setup(self, dim, kernels):
+        super().setup(dim, kernels)
+        self.gen = lds.HaltonN(dim, PRIME_TABLE[:dim])
+        self.n = max(N // dim, 10)
+        self.gen.slice(0, self.n)  # build the lookup tables outside of the timings
+
+    def time_pop(self, dim, kernels):
+        pop = self.gen.pop
+        for _ in range(self.n):
+            pop()
+
+    def time_pop_batch(self, dim, kernels):
+        self.gen.pop_batch(self.n)
+
+    def time_pop_batch_fortran(self, dim, kernels):
+        self.gen.pop_batch(self.n, "F")
+
+    def track_bytes_per_point(self, dim, kernels):
+        return bytes_per_point(lambda: self.gen.pop_batch(self.n), self.n)
+
+    track_bytes_per_point.unit = "bytes"
+
+
+class Parallel:
+    params = [1, 2, 4]
+    param_names = ["workers"]
+    timeout = 120
+
+    def time_generate_parallel(self, workers):
+        generate_parallel(lds.HaltonN(10, PRIME_TABLE[:10]), 20 * N, workers=workers)
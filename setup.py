@@ -6,11 +6,25 @@
     PyScaffold helps you to put up the scaffold of your new Python project.
     Learn more under: https://pyscaffold.org/
 """
-from setuptools import setup
+import sys
+
+from setuptools import Extension, setup
+
+# Optional compiled kernels (``lds_gen._native``). The build is allowed to fail,
+# in which case the package runs on its pure-Python code. Floating-point
+# contraction must stay off so that the results match the Python code bit for bit.
+native = Extension(
+    "lds_gen._native",
+    sources=["src/lds_gen/_native.c"],
+    extra_compile_args=(
+        ["/fp:precise"] if sys.platform == "win32" else ["-ffp-contract=off"]
+    ),
+    optional=True,
+)
 
 if __name__ == "__main__":
     try:
-        setup(use_scm_version={"version_scheme": "no-guess-dev"})
+        setup(use_scm_version={"version_scheme": "no-guess-dev"}, ext_modules=[native])
     except:  # noqa
         print(
             "\n\nAn error occurred while building the project, "
@@ -0,0 +1,1304 @@
+/*
+ * Optional compiled kernels for lds_gen.
+ *
+ * Every function here mirrors a pure-Python routine of `lds.py` or `ilds.py`
+ * and performs the same floating-point operations in the same order, so that
+ * the results are bit-for-bit identical. Keep floating-point contraction off
+ * when compiling (see setup.py): fusing `1.0 - c * c` into an FMA would
+ * change the last bit of some results.
+ *
+ * Indices that do not fit into 64 bits are handled with Python integers for
+ * the scalar functions; the batch functions raise OverflowError and leave
+ * such ranges to the pure-Python code.
+ *
+ * `set_engine` selects the radical inverses of all kernels: the float64 digit
+ * loop of `lds.vdc` or the integer arithmetic of `lds.vdc_fixed`.
+ *
+ * The DLPack export at the end has no pure-Python counterpart: without this
+ * module `block.PointBlock.__dlpack__` raises BufferError.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+static const double TWO_PI = 2.0 * 3.14159265358979323846;
+static const double HALF_PI = 3.14159265358979323846 / 2.0;
+
+/* ---- kernels ---- */
+
+static double vdc_float_u64(uint64_t k, uint64_t base) {
+    double res = 0.0;
+    double denom = 1.0;
+    while (k != 0) {
+        denom *= (double)base;
+        uint64_t remainder = k % base;
+        k /= base;
+        res += (double)remainder / denom;
+    }
+    return res;
+}
+
+static uint64_t vdc_i_u64(uint64_t k, uint64_t base, uint64_t factor) {
+    uint64_t vdc = 0;
+    while (k != 0) {
+        factor /= base;
+        uint64_t remainder = k % base;
+        k /= base;
+        vdc += remainder * factor;
+    }
+    return vdc;
+}
+
+/* The fixed-point engine (see lds.vdc_fixed): the digits of k reversed into
+ * the integer numerator of vdc(k) * base**digits, converted with a single
+ * multiplication. A 64-bit index can have one digit more than fits. */
+static double vdc_fixed_u64(uint64_t k, uint64_t base) {
+    uint64_t num = 0;
+    uint64_t den = 1;
+    uint64_t limit = UINT64_MAX / base;
+    while (k != 0 && den <= limit) {
+        num = num * base + k % base;
+        k /= base;
+        den *= base;
+    }
+    return ((double)num + (double)k / (double)base) * (1.0 / (double)den);
+}
+
+/* Engine of the radical inverses of all kernels, set by lds.set_engine */
+static int fixed_engine = 0;
+
+static double vdc_u64(uint64_t k, uint64_t base) {
+    return fixed_engine ? vdc_fixed_u64(k, base) : vdc_float_u64(k, base);
+}
+
+/* base**scale, or 0 if it does not fit into 64 bits */
+static uint64_t power_u64(uint64_t base, unsigned long scale) {
+    uint64_t res = 1;
+    for (unsigned long i = 0; i < scale; ++i) {
+        if (res > UINT64_MAX / base) {
+            return 0;
+        }
+        res *= base;
+    }
+    return res;
+}
+
+/* ---- argument helpers ---- */
+
+/* Return value of the batch functions: None, or NULL if an error is set */
+static PyObject *done(void) {
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static int check_index(PyObject *k) {
+    PyObject *zero = PyLong_FromLong(0);
+    int negative = zero ? PyObject_RichCompareBool(k, zero, Py_LT) : -1;
+    Py_XDECREF(zero);
+    if (negative > 0) {
+        PyErr_SetString(PyExc_ValueError, "k must be non-negative");
+    }
+    return negative == 0 ? 0 : -1;
+}
+
+static int check_base(unsigned long long base) {
+    if (base < 2) {
+        PyErr_SetString(PyExc_ValueError, "base must be at least 2");
+        return -1;
+    }
+    return 0;
+}
+
+/* Index range start, start + step, ... of n entries, all in [0, 2**64) */
+static int check_range(PyObject *start_obj, PyObject *step_obj, Py_ssize_t n,
+                       uint64_t *start, int64_t *step) {
+    *start = PyLong_AsUnsignedLongLong(start_obj);
+    if (PyErr_Occurred()) {
+        return -1;
+    }
+    *step = PyLong_AsLongLong(step_obj);
+    if (PyErr_Occurred()) {
+        return -1;
+    }
+    if (n > 0) {
+        uint64_t count = (uint64_t)(n - 1);
+        uint64_t span = *step < 0 ? (uint64_t)(-(*step + 1)) + 1 : (uint64_t)*step;
+        if (span != 0 && count > UINT64_MAX / span) {
+            goto overflow;
+        }
+        uint64_t dist = count * span;
+        if (*step < 0 ? dist > *start : dist > UINT64_MAX - *start) {
+            goto overflow;
+        }
+    }
+    return 0;
+overflow:
+    PyErr_SetString(PyExc_OverflowError, "index range does not fit into 64 bits");
+    return -1;
+}
+
+/* Get a buffer of float64 values, or of float32 values as well if `single` is
+ * set; the values of such an output buffer are stored with put() */
+static int get_floats(PyObject *obj, Py_buffer *view, int single) {
+    if (PyObject_GetBuffer(obj, view, PyBUF_WRITABLE | PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) < 0) {
+        return -1;
+    }
+    const char *fmt = view->format;
+    if (*fmt == '@' || *fmt == '=') {
+        ++fmt;
+    }
+    if (strcmp(fmt, "d") != 0 && (!single || strcmp(fmt, "f") != 0)) {
+        PyErr_Format(PyExc_TypeError, "output buffer must hold %s values, got '%s'",
+                     single ? "float64 or float32" : "float64", view->format);
+        PyBuffer_Release(view);
+        return -1;
+    }
+    return 0;
+}
+
+static int get_doubles(PyObject *obj, Py_buffer *view) {
+    return get_floats(obj, view, 0);
+}
+
+/* Store entry i of a buffer of get_floats(), rounding to float32 if it holds
+ * float32 values, as array("f") does */
+static void put(const Py_buffer *view, Py_ssize_t i, double value) {
+    if (view->itemsize == (Py_ssize_t)sizeof(float)) {
+        ((float *)view->buf)[i] = (float)value;
+    } else {
+        ((double *)view->buf)[i] = value;
+    }
+}
+
+/* Get n equally sized double buffers; n is taken from the first one */
+static int get_columns(PyObject *const *objs, int count, Py_buffer *views, Py_ssize_t *n) {
+    for (int j = 0; j < count; ++j) {
+        if (get_doubles(objs[j], &views[j]) < 0) {
+            while (j-- > 0) {
+                PyBuffer_Release(&views[j]);
+            }
+            return -1;
+        }
+    }
+    *n = views[0].len / (Py_ssize_t)sizeof(double);
+    for (int j = 1; j < count; ++j) {
+        if (views[j].len != views[0].len) {
+            PyErr_SetString(PyExc_ValueError, "output buffers differ in size");
+            for (j = 0; j < count; ++j) {
+                PyBuffer_Release(&views[j]);
+            }
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Get a read-only buffer of unsigned integers (typecodes B, H, I, L or Q) */
+static int get_uints(PyObject *obj, Py_buffer *view) {
+    if (PyObject_GetBuffer(obj, view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) < 0) {
+        return -1;
+    }
+    const char *fmt = view->format;
+    if (*fmt == '@' || *fmt == '=') {
+        ++fmt;
+    }
+    if (strlen(fmt) != 1 || strchr("BHILQ", *fmt) == NULL ||
+        (view->itemsize != 1 && view->itemsize != 2 && view->itemsize != 4 &&
+         view->itemsize != 8)) {
+        PyErr_Format(PyExc_TypeError, "table must hold unsigned integers, got '%s'",
+                     view->format);
+        PyBuffer_Release(view);
+        return -1;
+    }
+    return 0;
+}
+
+static uint64_t uint_at(const Py_buffer *view, Py_ssize_t i) {
+    switch (view->itemsize) {
+    case 1:
+        return ((const uint8_t *)view->buf)[i];
+    case 2:
+        return ((const uint16_t *)view->buf)[i];
+    case 4:
+        return ((const uint32_t *)view->buf)[i];
+    default:
+        return ((const uint64_t *)view->buf)[i];
+    }
+}
+
+/* Weights base**(m - 1 - j) of the m scrambled digits; fails unless
+ * base**m <= 2**53, so that numerator and denominator are exact doubles */
+static int digit_weights(uint64_t base, Py_ssize_t m, uint64_t *weights, double *scale) {
+    uint64_t power = 1;
+    if (m < 1 || m > 64) {
+        PyErr_SetString(PyExc_ValueError, "number of digits must be in [1, 64]");
+        return -1;
+    }
+    for (Py_ssize_t j = m; j-- > 0;) {
+        weights[j] = power;
+        if (power > (UINT64_C(1) << 53) / base) {
+            PyErr_SetString(PyExc_OverflowError, "base**digits exceeds 2**53");
+            return -1;
+        }
+        power *= base;
+    }
+    *scale = (double)power;
+    return 0;
+}
+
+/* ---- scalar functions ---- */
+
+static PyObject *vdc_big(PyObject *k, unsigned long long base) {
+    double res = 0.0;
+    double denom = 1.0;
+    PyObject *b = PyLong_FromUnsignedLongLong(base);
+    if (b == NULL) {
+        return NULL;
+    }
+    Py_INCREF(k);
+    for (;;) {
+        int nonzero = PyObject_IsTrue(k);
+        if (nonzero <= 0) {
+            Py_DECREF(k);
+            Py_DECREF(b);
+            return nonzero < 0 ? NULL : PyFloat_FromDouble(res);
+        }
+        PyObject *qr = PyNumber_Divmod(k, b);
+        Py_DECREF(k);
+        if (qr == NULL) {
+            Py_DECREF(b);
+            return NULL;
+        }
+        unsigned long long remainder = PyLong_AsUnsignedLongLong(PyTuple_GET_ITEM(qr, 1));
+        k = PyTuple_GET_ITEM(qr, 0);
+        Py_INCREF(k);
+        Py_DECREF(qr);
+        denom *= (double)base;
+        res += (double)remainder / denom;
+    }
+}
+
+/* The fixed-point engine beyond 64 bits is left to lds.vdc_fixed */
+static PyObject *vdc_fixed_big(PyObject *k, unsigned long long base) {
+    PyObject *module = PyImport_ImportModule("lds_gen.lds");
+    if (module == NULL) {
+        return NULL;
+    }
+    PyObject *res = PyObject_CallMethod(module, "vdc_fixed", "OK", k, base);
+    Py_DECREF(module);
+    return res;
+}
+
+static PyObject *native_vdc(PyObject *self, PyObject *args) {
+    PyObject *obj, *k_obj, *res;
+    unsigned long long base = 2;
+    if (!PyArg_ParseTuple(args, "O|K:vdc", &obj, &base) || check_base(base) < 0 ||
+        (k_obj = PyNumber_Index(obj)) == NULL) {
+        return NULL;
+    }
+    if (check_index(k_obj) < 0) {
+        res = NULL;
+    } else {
+        uint64_t k = PyLong_AsUnsignedLongLong(k_obj);
+        if (PyErr_Occurred()) {
+            PyErr_Clear();
+            res = fixed_engine ? vdc_fixed_big(k_obj, base) : vdc_big(k_obj, base);
+        } else {
+            res = PyFloat_FromDouble(vdc_u64(k, base));
+        }
+    }
+    Py_DECREF(k_obj);
+    return res;
+}
+
+static PyObject *vdc_i_big(PyObject *k, unsigned long long base, unsigned long scale) {
+    PyObject *b = PyLong_FromUnsignedLongLong(base);
+    PyObject *s = PyLong_FromUnsignedLong(scale);
+    PyObject *factor = (b && s) ? PyNumber_Power(b, s, Py_None) : NULL;
+    PyObject *vdc = factor ? PyLong_FromLong(0) : NULL;
+    Py_XDECREF(s);
+    Py_INCREF(k);
+    while (vdc != NULL) {
+        int nonzero = PyObject_IsTrue(k);
+        if (nonzero <= 0) {
+            if (nonzero < 0) {
+                Py_CLEAR(vdc);
+            }
+            break;
+        }
+        PyObject *qr = PyNumber_Divmod(k, b);
+        Py_SETREF(factor, PyNumber_FloorDivide(factor, b));
+        PyObject *term = (qr && factor) ? PyNumber_Multiply(PyTuple_GET_ITEM(qr, 1), factor) : NULL;
+        if (term == NULL) {
+            Py_XDECREF(qr);
+            Py_CLEAR(vdc);
+            break;
+        }
+        Py_SETREF(vdc, PyNumber_Add(vdc, term));
+        Py_DECREF(term);
+        Py_SETREF(k, PyTuple_GET_ITEM(qr, 0));
+        Py_INCREF(k);
+        Py_DECREF(qr);
+    }
+    Py_DECREF(k);
+    Py_XDECREF(b);
+    Py_XDECREF(factor);
+    return vdc;
+}
+
+/* The optional `factor` is the cached `base**scale` of the generators; 0 if it does not fit */
+static PyObject *native_vdc_i(PyObject *self, PyObject *args) {
+    PyObject *obj, *k_obj, *res, *factor_obj = NULL;
+    unsigned long long base = 2;
+    unsigned long scale = 10;
+    if (!PyArg_ParseTuple(args, "O|KkO!:vdc_i", &obj, &base, &scale, &PyLong_Type,
+                          &factor_obj) ||
+        check_base(base) < 0 || (k_obj = PyNumber_Index(obj)) == NULL) {
+        return NULL;
+    }
+    if (check_index(k_obj) < 0) {
+        res = NULL;
+    } else {
+        uint64_t factor;
+        if (factor_obj == NULL) {
+            factor = power_u64(base, scale);
+        } else {
+            factor = PyLong_AsUnsignedLongLong(factor_obj);
+            if (PyErr_Occurred()) {
+                PyErr_Clear();
+                factor = 0;
+            }
+        }
+        uint64_t k = PyLong_AsUnsignedLongLong(k_obj);
+        if (PyErr_Occurred() || factor == 0) {
+            PyErr_Clear();
+            res = vdc_i_big(k_obj, base, scale);
+        } else {
+            res = PyLong_FromUnsignedLongLong(vdc_i_u64(k, base, factor));
+        }
+    }
+    Py_DECREF(k_obj);
+    return res;
+}
+
+/* ---- batch functions ---- */
+
+static PyObject *native_vdc_fill(PyObject *self, PyObject *args) {
+    PyObject *out, *start_obj, *step_obj;
+    unsigned long long base;
+    Py_buffer view;
+    uint64_t start;
+    int64_t step;
+    if (!PyArg_ParseTuple(args, "OO!O!K:vdc_fill", &out, &PyLong_Type, &start_obj, &PyLong_Type,
+                          &step_obj, &base) ||
+        check_base(base) < 0 || get_floats(out, &view, 1) < 0) {
+        return NULL;
+    }
+    Py_ssize_t n = view.len / view.itemsize;
+    if (check_range(start_obj, step_obj, n, &start, &step) < 0) {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    uint64_t k = start;
+    for (Py_ssize_t i = 0; i < n; ++i, k += (uint64_t)step) {
+        put(&view, i, vdc_u64(k, base));
+    }
+    Py_END_ALLOW_THREADS
+    PyBuffer_Release(&view);
+    Py_RETURN_NONE;
+}
+
+static PyObject *native_vdc_i_fill(PyObject *self, PyObject *args) {
+    PyObject *out, *start_obj, *step_obj;
+    unsigned long long base;
+    unsigned long scale;
+    Py_buffer view;
+    uint64_t start;
+    int64_t step;
+    if (!PyArg_ParseTuple(args, "OO!O!Kk:vdc_i_fill", &out, &PyLong_Type, &start_obj,
+                          &PyLong_Type, &step_obj, &base, &scale) ||
+        check_base(base) < 0) {
+        return NULL;
+    }
+    uint64_t factor = power_u64(base, scale);
+    if (factor == 0) {
+        PyErr_SetString(PyExc_OverflowError, "base**scale does not fit into 64 bits");
+        return NULL;
+    }
+    if (PyObject_GetBuffer(out, &view, PyBUF_WRITABLE | PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) < 0) {
+        return NULL;
+    }
+    const char *fmt = view.format;
+    if (*fmt == '@' || *fmt == '=') {
+        ++fmt;
+    }
+    if (strlen(fmt) != 1 || strchr("BHILQ", *fmt) == NULL) {
+        PyErr_Format(PyExc_TypeError, "output buffer must hold unsigned integers, got '%s'",
+                     view.format);
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+    Py_ssize_t size = view.itemsize;
+    Py_ssize_t n = view.len / size;
+    if (check_range(start_obj, step_obj, n, &start, &step) < 0) {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+    uint64_t limit = size >= 8 ? UINT64_MAX : (((uint64_t)1) << (8 * size)) - 1;
+    int overflow = 0;
+    Py_BEGIN_ALLOW_THREADS
+    uint64_t k = start;
+    char *buf = (char *)view.buf;
+    for (Py_ssize_t i = 0; i < n; ++i, k += (uint64_t)step) {
+        uint64_t v = vdc_i_u64(k, base, factor);
+        if (v > limit) {
+            overflow = 1;
+            break;
+        }
+        switch (size) {
+        case 1: ((uint8_t *)buf)[i] = (uint8_t)v; break;
+        case 2: ((uint16_t *)buf)[i] = (uint16_t)v; break;
+        case 4: ((uint32_t *)buf)[i] = (uint32_t)v; break;
+        default: ((uint64_t *)buf)[i] = v; break;
+        }
+    }
+    Py_END_ALLOW_THREADS
+    PyBuffer_Release(&view);
+    if (overflow) {
+        PyErr_SetString(PyExc_OverflowError, "value does not fit into the output buffer");
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *native_circle_fill(PyObject *self, PyObject *args) {
+    PyObject *cols[2], *start_obj, *step_obj;
+    unsigned long long base;
+    Py_buffer views[2];
+    Py_ssize_t n;
+    uint64_t start;
+    int64_t step;
+    if (!PyArg_ParseTuple(args, "OOO!O!K:circle_fill", &cols[0], &cols[1], &PyLong_Type,
+                          &start_obj, &PyLong_Type, &step_obj, &base) ||
+        check_base(base) < 0 || get_columns(cols, 2, views, &n) < 0) {
+        return NULL;
+    }
+    if (check_range(start_obj, step_obj, n, &start, &step) == 0) {
+        double *s = (double *)views[0].buf, *c = (double *)views[1].buf;
+        Py_BEGIN_ALLOW_THREADS
+        uint64_t k = start;
+        for (Py_ssize_t i = 0; i < n; ++i, k += (uint64_t)step) {
+            double theta = vdc_u64(k, base) * TWO_PI;
+            s[i] = sin(theta);
+            c[i] = cos(theta);
+        }
+        Py_END_ALLOW_THREADS
+    }
+    PyBuffer_Release(&views[0]);
+    PyBuffer_Release(&views[1]);
+    return done();
+}
+
+/* Angle addition: sin and cos of 2 * pi * vdc(k, base) from the angle of the
+ * lowest digits of k, tabulated in lo_sin and lo_cos (see lds._unit_circle),
+ * and the angle of the remaining digits, evaluated whenever they change. */
+typedef struct {
+    const double *lo_sin, *lo_cos;
+    uint64_t span, base, hi;
+    double sh, ch;
+} angle_table;
+
+static void angle_init(angle_table *t, const Py_buffer *views, uint64_t base) {
+    t->lo_sin = (const double *)views[0].buf;
+    t->lo_cos = (const double *)views[1].buf;
+    t->span = (uint64_t)(views[0].len / (Py_ssize_t)sizeof(double));
+    t->base = base;
+    t->hi = UINT64_MAX; /* k / span < UINT64_MAX as span >= 2 */
+}
+
+static void angle_sincos(angle_table *t, uint64_t k, double *s, double *c) {
+    uint64_t hi = k / t->span;
+    uint64_t lo = k % t->span;
+    if (hi != t->hi) {
+        double theta = vdc_u64(hi, t->base) / (double)t->span * TWO_PI;
+        t->sh = sin(theta);
+        t->ch = cos(theta);
+        t->hi = hi;
+    }
+    *s = t->lo_sin[lo] * t->ch + t->lo_cos[lo] * t->sh;
+    *c = t->lo_cos[lo] * t->ch - t->lo_sin[lo] * t->sh;
+}
+
+static void release(Py_buffer *views, int count) {
+    for (int j = 0; j < count; ++j) {
+        PyBuffer_Release(&views[j]);
+    }
+}
+
+/* Get the pairs of angle tables objs[2 * j], objs[2 * j + 1] */
+static int get_tables(PyObject *const *objs, int count, Py_buffer *views) {
+    for (int j = 0; j < count; ++j) {
+        Py_ssize_t span;
+        if (get_columns(objs + 2 * j, 2, views + 2 * j, &span) < 0) {
+            release(views, 2 * j);
+            return -1;
+        }
+        if (span < 2) {
+            release(views, 2 * j + 2);
+            PyErr_SetString(PyExc_ValueError, "angle tables need at least two entries");
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static PyObject *native_circle_table_fill(PyObject *self, PyObject *args) {
+    PyObject *cols[2], *tables[2], *start_obj, *step_obj;
+    unsigned long long base;
+    Py_buffer views[2], table_views[2];
+    Py_ssize_t n;
+    uint64_t start;
+    int64_t step;
+    if (!PyArg_ParseTuple(args, "OOOOO!O!K:circle_table_fill", &cols[0], &cols[1], &tables[0],
+                          &tables[1], &PyLong_Type, &start_obj, &PyLong_Type, &step_obj, &base) ||
+        check_base(base) < 0 || get_columns(cols, 2, views, &n) < 0) {
+        return NULL;
+    }
+    if (get_tables(tables, 1, table_views) < 0) {
+        release(views, 2);
+        return NULL;
+    }
+    if (check_range(start_obj, step_obj, n, &start, &step) == 0) {
+        double *s = (double *)views[0].buf, *c = (double *)views[1].buf;
+        angle_table t;
+        angle_init(&t, table_views, base);
+        Py_BEGIN_ALLOW_THREADS
+        uint64_t k = start;
+        for (Py_ssize_t i = 0; i < n; ++i, k += (uint64_t)step) {
+            angle_sincos(&t, k, &s[i], &c[i]);
+        }
+        Py_END_ALLOW_THREADS
+    }
+    release(views, 2);
+    release(table_views, 2);
+    return done();
+}
+
+static PyObject *native_sphere_table_fill(PyObject *self, PyObject *args) {
+    PyObject *cols[3], *tables[2], *start_obj, *step_obj;
+    unsigned long long base0, base1;
+    Py_buffer views[3], table_views[2];
+    Py_ssize_t n;
+    uint64_t start;
+    int64_t step;
+    if (!PyArg_ParseTuple(args, "OOOOOO!O!KK:sphere_table_fill", &cols[0], &cols[1], &cols[2],
+                          &tables[0], &tables[1], &PyLong_Type, &start_obj, &PyLong_Type,
+                          &step_obj, &base0, &base1) ||
+        check_base(base0) < 0 || check_base(base1) < 0 || get_columns(cols, 3, views, &n) < 0) {
+        return NULL;
+    }
+    if (get_tables(tables, 1, table_views) < 0) {
+        release(views, 3);
+        return NULL;
+    }
+    if (check_range(start_obj, step_obj, n, &start, &step) == 0) {
+        double *x = (double *)views[0].buf, *y = (double *)views[1].buf;
+        double *z = (double *)views[2].buf;
+        angle_table t;
+        angle_init(&t, table_views, base1);
+        Py_BEGIN_ALLOW_THREADS
+        uint64_t k = start;
+        for (Py_ssize_t i = 0; i < n; ++i, k += (uint64_t)step) {
+            double cosphi = 2.0 * vdc_u64(k, base0) - 1.0;
+            double sinphi = sqrt(1.0 - cosphi * cosphi);
+            double s, c;
+            angle_sincos(&t, k, &s, &c);
+            x[i] = sinphi * s;
+            y[i] = sinphi * c;
+            z[i] = cosphi;
+        }
+        Py_END_ALLOW_THREADS
+    }
+    release(views, 3);
+    release(table_views, 2);
+    return done();
+}
+
+static PyObject *native_sphere3hopf_table_fill(PyObject *self, PyObject *args) {
+    PyObject *cols[4], *tables[4], *start_obj, *step_obj;
+    unsigned long long base0, base1, base2;
+    Py_buffer views[4], table_views[4];
+    Py_ssize_t n;
+    uint64_t start;
+    int64_t step;
+    if (!PyArg_ParseTuple(args, "OOOOOOOOO!O!KKK:sphere3hopf_table_fill", &cols[0], &cols[1],
+                          &cols[2], &cols[3], &tables[0], &tables[1], &tables[2], &tables[3],
+                          &PyLong_Type, &start_obj, &PyLong_Type, &step_obj, &base0, &base1,
+                          &base2) ||
+        check_base(base0) < 0 || check_base(base1) < 0 || check_base(base2) < 0 ||
+        get_columns(cols, 4, views, &n) < 0) {
+        return NULL;
+    }
+    if (get_tables(tables, 2, table_views) < 0) {
+        release(views, 4);
+        return NULL;
+    }
+    if (check_range(start_obj, step_obj, n, &start, &step) == 0) {
+        double *a = (double *)views[0].buf, *b = (double *)views[1].buf;
+        double *c = (double *)views[2].buf, *d = (double *)views[3].buf;
+        angle_table t0, t1;
+        angle_init(&t0, table_views, base0);
+        angle_init(&t1, table_views + 2, base1);
+        Py_BEGIN_ALLOW_THREADS
+        uint64_t k = start;
+        for (Py_ssize_t i = 0; i < n; ++i, k += (uint64_t)step) {
+            double sin_phi, cos_phi, sin_psy, cos_psy;
+            angle_sincos(&t0, k, &sin_phi, &cos_phi);
+            angle_sincos(&t1, k, &sin_psy, &cos_psy);
+            double vd = vdc_u64(k, base2);
+            double cos_eta = sqrt(vd);
+            double sin_eta = sqrt(1.0 - vd);
+            a[i] = cos_eta * cos_psy;
+            b[i] = cos_eta * sin_psy;
+            c[i] = sin_eta * (cos_phi * cos_psy - sin_phi * sin_psy);
+            d[i] = sin_eta * (sin_phi * cos_psy + cos_phi * sin_psy);
+        }
+        Py_END_ALLOW_THREADS
+    }
+    release(views, 4);
+    release(table_views, 4);
+    return done();
+}
+
+static PyObject *native_sphere_fill(PyObject *self, PyObject *args) {
+    PyObject *cols[3], *start_obj, *step_obj;
+    unsigned long long base0, base1;
+    Py_buffer views[3];
+    Py_ssize_t n;
+    uint64_t start;
+    int64_t step;
+    if (!PyArg_ParseTuple(args, "OOOO!O!KK:sphere_fill", &cols[0], &cols[1], &cols[2],
+                          &PyLong_Type, &start_obj, &PyLong_Type, &step_obj, &base0, &base1) ||
+        check_base(base0) < 0 || check_base(base1) < 0 || get_columns(cols, 3, views, &n) < 0) {
+        return NULL;
+    }
+    if (check_range(start_obj, step_obj, n, &start, &step) == 0) {
+        double *x = (double *)views[0].buf, *y = (double *)views[1].buf;
+        double *z = (double *)views[2].buf;
+        Py_BEGIN_ALLOW_THREADS
+        uint64_t k = start;
+        for (Py_ssize_t i = 0; i < n; ++i, k += (uint64_t)step) {
+            double cosphi = 2.0 * vdc_u64(k, base0) - 1.0;
+            double sinphi = sqrt(1.0 - cosphi * cosphi);
+            double theta = vdc_u64(k, base1) * TWO_PI;
+            x[i] = sinphi * sin(theta);
+            y[i] = sinphi * cos(theta);
+            z[i] = cosphi;
+        }
+        Py_END_ALLOW_THREADS
+    }
+    for (int j = 0; j < 3; ++j) {
+        PyBuffer_Release(&views[j]);
+    }
+    return done();
+}
+
+static PyObject *native_sphere3hopf_fill(PyObject *self, PyObject *args) {
+    PyObject *cols[4], *start_obj, *step_obj;
+    unsigned long long base0, base1, base2;
+    Py_buffer views[4];
+    Py_ssize_t n;
+    uint64_t start;
+    int64_t step;
+    if (!PyArg_ParseTuple(args, "OOOOO!O!KKK:sphere3hopf_fill", &cols[0], &cols[1], &cols[2],
+                          &cols[3], &PyLong_Type, &start_obj, &PyLong_Type, &step_obj, &base0,
+                          &base1, &base2) ||
+        check_base(base0) < 0 || check_base(base1) < 0 || check_base(base2) < 0 ||
+        get_columns(cols, 4, views, &n) < 0) {
+        return NULL;
+    }
+    if (check_range(start_obj, step_obj, n, &start, &step) == 0) {
+        double *a = (double *)views[0].buf, *b = (double *)views[1].buf;
+        double *c = (double *)views[2].buf, *d = (double *)views[3].buf;
+        Py_BEGIN_ALLOW_THREADS
+        uint64_t k = start;
+        for (Py_ssize_t i = 0; i < n; ++i, k += (uint64_t)step) {
+            double phi = vdc_u64(k, base0) * TWO_PI;
+            double psy = vdc_u64(k, base1) * TWO_PI;
+            double vd = vdc_u64(k, base2);
+            double cos_eta = sqrt(vd);
+            double sin_eta = sqrt(1.0 - vd);
+            a[i] = cos_eta * cos(psy);
+            b[i] = cos_eta * sin(psy);
+            c[i] = sin_eta * cos(phi + psy);
+            d[i] = sin_eta * sin(phi + psy);
+        }
+        Py_END_ALLOW_THREADS
+    }
+    for (int j = 0; j < 4; ++j) {
+        PyBuffer_Release(&views[j]);
+    }
+    return done();
+}
+
+/* Polar angle of SphereN (see sphere_n._polar): theta with cdf(theta) == u for
+ * the density norm * sin(theta)**k, from a table of the cumulative distribution
+ * cdf and the density dens on a uniform grid of [0, pi/2] and two Newton steps. */
+static void polar_sincos(const double *cdf, const double *dens, Py_ssize_t cells, double k,
+                         double norm, double u, double *s, double *c) {
+    int flip = u > 0.5;
+    if (flip) {
+        u = 1.0 - u;
+    }
+    double h = HALF_PI / (double)cells;
+    /* bisect_right(cdf, u), clamped to the last cell */
+    Py_ssize_t lo_i = 0, hi_i = cells + 1;
+    while (lo_i < hi_i) {
+        Py_ssize_t mid = (lo_i + hi_i) / 2;
+        if (u < cdf[mid]) {
+            hi_i = mid;
+        } else {
+            lo_i = mid + 1;
+        }
+    }
+    Py_ssize_t i = (lo_i < cells ? lo_i : cells) - 1;
+    double lo = (double)i * h;
+    double theta;
+    if (i == 0) {
+        theta = pow((k + 1.0) * u / norm, 1.0 / (k + 1.0));
+    } else {
+        theta = lo + (u - cdf[i]) / (cdf[i + 1] - cdf[i]) * h;
+    }
+    for (int step = 0; step < 2; ++step) {
+        double d = theta - lo;
+        double ft = norm * pow(sin(theta), k);
+        if (ft == 0.0) {
+            break;
+        }
+        double mass = cdf[i] + d * (dens[i] + 4.0 * norm * pow(sin(lo + 0.5 * d), k) + ft) / 6.0;
+        theta = theta - (mass - u) / ft;
+        if (theta < lo) {
+            theta = lo;
+        } else if (theta > lo + h) {
+            theta = lo + h;
+        }
+    }
+    *s = sin(theta);
+    *c = flip ? -cos(theta) : cos(theta);
+}
+
+static PyObject *native_polar_fill(PyObject *self, PyObject *args) {
+    PyObject *cols[2], *tables[2], *start_obj, *step_obj;
+    unsigned long long base;
+    int k;
+    double norm;
+    Py_buffer views[2], table_views[2];
+    Py_ssize_t n, cells;
+    uint64_t start;
+    int64_t step;
+    if (!PyArg_ParseTuple(args, "OOOOO!O!Kid:polar_fill", &cols[0], &cols[1], &tables[0],
+                          &tables[1], &PyLong_Type, &start_obj, &PyLong_Type, &step_obj, &base,
+                          &k, &norm) ||
+        check_base(base) < 0 || get_columns(cols, 2, views, &n) < 0) {
+        return NULL;
+    }
+    if (get_columns(tables, 2, table_views, &cells) < 0) {
+        release(views, 2);
+        return NULL;
+    }
+    if (cells < 3) {
+        PyErr_SetString(PyExc_ValueError, "polar tables need at least three entries");
+    } else if (check_range(start_obj, step_obj, n, &start, &step) == 0) {
+        double *coord = (double *)views[0].buf, *scale = (double *)views[1].buf;
+        const double *cdf = (const double *)table_views[0].buf;
+        const double *dens = (const double *)table_views[1].buf;
+        Py_BEGIN_ALLOW_THREADS
+        uint64_t j = start;
+        for (Py_ssize_t i = 0; i < n; ++i, j += (uint64_t)step) {
+            double s, c;
+            polar_sincos(cdf, dens, cells - 1, (double)k, norm, vdc_u64(j, base), &s, &c);
+            coord[i] = c * scale[i];
+            scale[i] *= s;
+        }
+        Py_END_ALLOW_THREADS
+    }
+    release(views, 2);
+    release(table_views, 2);
+    return done();
+}
+
+/* Scrambled van der Corput values (see scrambled.ScrambledVdCorput): digit j of
+ * k is replaced by perms[j * base + digit], digits from position m on are
+ * dropped. */
+static PyObject *native_permute_fill(PyObject *self, PyObject *args) {
+    PyObject *out, *perms_obj, *start_obj, *step_obj;
+    unsigned long long base;
+    Py_buffer view, perms;
+    uint64_t start, weights[64], tail[65];
+    int64_t step;
+    double scale;
+    if (!PyArg_ParseTuple(args, "OO!O!KO:permute_fill", &out, &PyLong_Type, &start_obj,
+                          &PyLong_Type, &step_obj, &base, &perms_obj) ||
+        check_base(base) < 0 || get_floats(out, &view, 1) < 0) {
+        return NULL;
+    }
+    if (get_uints(perms_obj, &perms) < 0) {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+    Py_ssize_t n = view.len / view.itemsize;
+    Py_ssize_t size = perms.len / perms.itemsize;
+    Py_ssize_t m = size / (Py_ssize_t)base;
+    if ((uint64_t)size != (uint64_t)m * base) {
+        PyErr_SetString(PyExc_ValueError, "table size must be a multiple of base");
+    } else if (digit_weights(base, m, weights, &scale) == 0 &&
+               check_range(start_obj, step_obj, n, &start, &step) == 0) {
+        /* tail[j]: the numerator of the dropped leading zero digits j, j + 1, ... */
+        tail[m] = 0;
+        for (Py_ssize_t j = m; j-- > 0;) {
+            tail[j] = tail[j + 1] + uint_at(&perms, j * (Py_ssize_t)base) * weights[j];
+        }
+        Py_BEGIN_ALLOW_THREADS
+        uint64_t k = start;
+        for (Py_ssize_t i = 0; i < n; ++i, k += (uint64_t)step) {
+            uint64_t rest = k, y = 0;
+            Py_ssize_t j = 0;
+            for (; rest != 0 && j < m; ++j) {
+                uint64_t digit = rest % base;
+                rest /= base;
+                y += uint_at(&perms, j * (Py_ssize_t)base + (Py_ssize_t)digit) * weights[j];
+            }
+            put(&view, i, (double)(y + tail[j]) / scale);
+        }
+        Py_END_ALLOW_THREADS
+    }
+    PyBuffer_Release(&view);
+    PyBuffer_Release(&perms);
+    return done();
+}
+
+/* Linearly scrambled van der Corput values: digit j becomes
+ * (shift[j] + sum_{i <= j} matrix[j * (j + 1) / 2 + i] * digit_i) % base. */
+static PyObject *native_linear_fill(PyObject *self, PyObject *args) {
+    PyObject *out, *matrix_obj, *shift_obj, *start_obj, *step_obj;
+    unsigned long long base;
+    Py_buffer view, tables[2];
+    uint64_t start, weights[64];
+    int64_t step;
+    double scale;
+    if (!PyArg_ParseTuple(args, "OO!O!KOO:linear_fill", &out, &PyLong_Type, &start_obj,
+                          &PyLong_Type, &step_obj, &base, &matrix_obj, &shift_obj) ||
+        check_base(base) < 0 || get_floats(out, &view, 1) < 0) {
+        return NULL;
+    }
+    if (get_uints(matrix_obj, &tables[0]) < 0) {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+    if (get_uints(shift_obj, &tables[1]) < 0) {
+        PyBuffer_Release(&view);
+        PyBuffer_Release(&tables[0]);
+        return NULL;
+    }
+    Py_ssize_t n = view.len / view.itemsize;
+    Py_ssize_t m = tables[1].len / tables[1].itemsize;
+    if (base > UINT32_MAX) {
+        PyErr_SetString(PyExc_OverflowError, "base must be below 2**32");
+    } else if (m < 1 || tables[0].len / tables[0].itemsize != m * (m + 1) / 2) {
+        PyErr_SetString(PyExc_ValueError, "matrix must be lower triangular of the shift size");
+    } else if (digit_weights(base, m, weights, &scale) == 0 &&
+               check_range(start_obj, step_obj, n, &start, &step) == 0) {
+        /* reduced copies; for bases below 2**28 a sum of up to 64 products stays
+         * below 2**63, so it is reduced only once */
+        uint64_t matrix[64 * 65 / 2], shift[64];
+        for (Py_ssize_t j = 0; j < m * (m + 1) / 2; ++j) {
+            matrix[j] = uint_at(&tables[0], j) % base;
+        }
+        for (Py_ssize_t j = 0; j < m; ++j) {
+            shift[j] = uint_at(&tables[1], j) % base;
+        }
+        int lazy = base < (UINT64_C(1) << 28);
+        Py_BEGIN_ALLOW_THREADS
+        uint64_t k = start;
+        for (Py_ssize_t i = 0; i < n; ++i, k += (uint64_t)step) {
+            uint64_t rest = k, y = 0, digits[64];
+            Py_ssize_t count = 0;
+            for (; rest != 0 && count < m; ++count) {
+                digits[count] = rest % base;
+                rest /= base;
+            }
+            for (Py_ssize_t j = 0; j < m; ++j) {
+                const uint64_t *row = matrix + j * (j + 1) / 2;
+                Py_ssize_t len = j + 1 < count ? j + 1 : count;
+                uint64_t acc = shift[j];
+                for (Py_ssize_t c = 0; c < len; ++c) {
+                    acc += row[c] * digits[c];
+                    if (!lazy) {
+                        acc %= base;
+                    }
+                }
+                y += acc % base * weights[j];
+            }
+            put(&view, i, (double)y / scale);
+        }
+        Py_END_ALLOW_THREADS
+    }
+    PyBuffer_Release(&view);
+    PyBuffer_Release(&tables[0]);
+    PyBuffer_Release(&tables[1]);
+    return done();
+}
+
+/* Copy of float64 values into every step-th entry of out from offset on,
+ * converted to float32 for a float32 buffer (see lds._store) */
+static PyObject *native_store_fill(PyObject *self, PyObject *args) {
+    PyObject *out, *values;
+    Py_ssize_t offset, step;
+    Py_buffer view, src;
+    if (!PyArg_ParseTuple(args, "OOnn:store_fill", &out, &values, &offset, &step) ||
+        get_floats(out, &view, 1) < 0) {
+        return NULL;
+    }
+    if (get_doubles(values, &src) < 0) {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+    Py_ssize_t n = src.len / (Py_ssize_t)sizeof(double);
+    Py_ssize_t size = view.len / view.itemsize;
+    if (offset < 0 || step < 1 ||
+        (n > 0 && (offset >= size || (size - 1 - offset) / step < n - 1))) {
+        PyErr_SetString(PyExc_ValueError, "values do not fit into the output buffer");
+    } else {
+        const double *vals = (const double *)src.buf;
+        Py_BEGIN_ALLOW_THREADS
+        for (Py_ssize_t i = 0; i < n; ++i) {
+            put(&view, offset + i * step, vals[i]);
+        }
+        Py_END_ALLOW_THREADS
+    }
+    PyBuffer_Release(&view);
+    PyBuffer_Release(&src);
+    return done();
+}
+
+/* Kronecker values: the top 53 bits of the 64-bit fixed-point coordinates
+ * x0 + i * delta (mod 2**64), see kronecker._column. */
+static PyObject *native_kronecker_fill(PyObject *self, PyObject *args) {
+    PyObject *out;
+    unsigned long long x0, delta;
+    Py_buffer view;
+    if (!PyArg_ParseTuple(args, "OKK:kronecker_fill", &out, &x0, &delta) ||
+        get_doubles(out, &view) < 0) {
+        return NULL;
+    }
+    Py_ssize_t n = view.len / (Py_ssize_t)sizeof(double);
+    double *res = (double *)view.buf;
+    Py_BEGIN_ALLOW_THREADS
+    uint64_t x = x0;
+    for (Py_ssize_t i = 0; i < n; ++i, x += delta) {
+        res[i] = (double)(x >> 11) * 0x1p-53;
+    }
+    Py_END_ALLOW_THREADS
+    PyBuffer_Release(&view);
+    Py_RETURN_NONE;
+}
+
+/* ---- Warnock's formula of the L2-star discrepancy (see discrepancy.py) ---- */
+
+/* out[j] += sum_i prod_k (1 - max(a[i][k], b[j][k])) over the rows of the
+ * row-major point blocks a and b of dim coordinates. */
+static PyObject *native_warnock_sums(PyObject *self, PyObject *args) {
+    PyObject *objs[3];
+    Py_ssize_t dim;
+    Py_buffer views[3];
+    if (!PyArg_ParseTuple(args, "OOOn:warnock_sums", &objs[0], &objs[1], &objs[2], &dim)) {
+        return NULL;
+    }
+    if (dim < 1) {
+        PyErr_SetString(PyExc_ValueError, "dim must be positive");
+        return NULL;
+    }
+    for (int j = 0; j < 3; ++j) {
+        if (get_doubles(objs[j], &views[j]) < 0) {
+            while (j-- > 0) {
+                PyBuffer_Release(&views[j]);
+            }
+            return NULL;
+        }
+    }
+    Py_ssize_t nb = views[0].len / (Py_ssize_t)sizeof(double);
+    Py_ssize_t na = views[1].len / (Py_ssize_t)sizeof(double) / dim;
+    if (views[2].len / (Py_ssize_t)sizeof(double) != nb * dim) {
+        PyErr_SetString(PyExc_ValueError, "out must hold one value per point of b");
+        for (int j = 0; j < 3; ++j) {
+            PyBuffer_Release(&views[j]);
+        }
+        return NULL;
+    }
+    double *out = (double *)views[0].buf;
+    const double *a = (const double *)views[1].buf;
+    const double *b = (const double *)views[2].buf;
+    Py_BEGIN_ALLOW_THREADS
+    for (Py_ssize_t j = 0; j < nb; ++j) {
+        const double *y = b + j * dim;
+        double sum = 0.0;
+        for (Py_ssize_t i = 0; i < na; ++i) {
+            const double *x = a + i * dim;
+            double prod = 1.0;
+            for (Py_ssize_t k = 0; k < dim; ++k) {
+                prod *= 1.0 - (x[k] > y[k] ? x[k] : y[k]);
+            }
+            sum += prod;
+        }
+        out[j] += sum;
+    }
+    Py_END_ALLOW_THREADS
+    for (int j = 0; j < 3; ++j) {
+        PyBuffer_Release(&views[j]);
+    }
+    Py_RETURN_NONE;
+}
+
+/* sum_i prod_k (1 - a[i][k]**2) over the rows of the point block a. */
+static PyObject *native_warnock_linear(PyObject *self, PyObject *args) {
+    PyObject *obj;
+    Py_ssize_t dim;
+    Py_buffer view;
+    if (!PyArg_ParseTuple(args, "On:warnock_linear", &obj, &dim)) {
+        return NULL;
+    }
+    if (dim < 1) {
+        PyErr_SetString(PyExc_ValueError, "dim must be positive");
+        return NULL;
+    }
+    if (get_doubles(obj, &view) < 0) {
+        return NULL;
+    }
+    Py_ssize_t n = view.len / (Py_ssize_t)sizeof(double) / dim;
+    const double *a = (const double *)view.buf;
+    double sum = 0.0;
+    Py_BEGIN_ALLOW_THREADS
+    for (Py_ssize_t i = 0; i < n; ++i) {
+        double prod = 1.0;
+        for (Py_ssize_t k = 0; k < dim; ++k) {
+            prod *= 1.0 - a[i * dim + k] * a[i * dim + k];
+        }
+        sum += prod;
+    }
+    Py_END_ALLOW_THREADS
+    PyBuffer_Release(&view);
+    return PyFloat_FromDouble(sum);
+}
+
+/* ---- DLPack export (see block.PointBlock.__dlpack__) ---- */
+
+/* The unversioned DLPack structures, laid out as in dlpack.h */
+typedef struct {
+    int32_t device_type;
+    int32_t device_id;
+} DLDevice;
+
+typedef struct {
+    uint8_t code;
+    uint8_t bits;
+    uint16_t lanes;
+} DLDataType;
+
+typedef struct {
+    void *data;
+    DLDevice device;
+    int32_t ndim;
+    DLDataType dtype;
+    int64_t *shape;
+    int64_t *strides;
+    uint64_t byte_offset;
+} DLTensor;
+
+typedef struct DLManagedTensor {
+    DLTensor dl_tensor;
+    void *manager_ctx;
+    void (*deleter)(struct DLManagedTensor *self);
+} DLManagedTensor;
+
+enum { DL_CPU = 1, DL_MAX_NDIM = 2 };
+
+/* The exported tensor, owning a buffer export of the block until the
+ * consumer (or the capsule, if it is never consumed) calls the deleter. */
+typedef struct {
+    DLManagedTensor managed;
+    Py_buffer view;
+    int64_t shape[DL_MAX_NDIM];
+    int64_t strides[DL_MAX_NDIM];
+} dlpack_export;
+
+static void dlpack_deleter(DLManagedTensor *managed) {
+    dlpack_export *export = (dlpack_export *)managed->manager_ctx;
+    /* consumers may delete the tensor from any thread */
+    PyGILState_STATE state = PyGILState_Ensure();
+    PyBuffer_Release(&export->view);
+    PyMem_Free(export);
+    PyGILState_Release(state);
+}
+
+static void dlpack_capsule_destructor(PyObject *capsule) {
+    /* a consumed capsule is renamed to "used_dltensor" and owned by the consumer */
+    if (PyCapsule_IsValid(capsule, "dltensor")) {
+        PyObject *type, *value, *traceback;
+        PyErr_Fetch(&type, &value, &traceback);
+        DLManagedTensor *managed = (DLManagedTensor *)PyCapsule_GetPointer(capsule, "dltensor");
+        if (managed != NULL) {
+            managed->deleter(managed);
+        }
+        PyErr_Restore(type, value, traceback);
+    }
+}
+
+static PyObject *native_dlpack(PyObject *self, PyObject *args) {
+    PyObject *obj, *shape, *strides;
+    int code, bits;
+    if (!PyArg_ParseTuple(args, "OO!O!ii:dlpack", &obj, &PyTuple_Type, &shape, &PyTuple_Type,
+                          &strides, &code, &bits)) {
+        return NULL;
+    }
+    Py_ssize_t ndim = PyTuple_GET_SIZE(shape);
+    if (ndim < 1 || ndim > DL_MAX_NDIM || PyTuple_GET_SIZE(strides) != ndim) {
+        PyErr_SetString(PyExc_ValueError, "shape and strides must have one or two entries");
+        return NULL;
+    }
+    if (code < 0 || code > UINT8_MAX || bits < 8 || bits > UINT8_MAX || bits % 8 != 0) {
+        PyErr_SetString(PyExc_ValueError, "invalid DLPack data type");
+        return NULL;
+    }
+    dlpack_export *export = (dlpack_export *)PyMem_Calloc(1, sizeof(dlpack_export));
+    if (export == NULL) {
+        return PyErr_NoMemory();
+    }
+    if (PyObject_GetBuffer(obj, &export->view, PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS) < 0) {
+        PyMem_Free(export);
+        return NULL;
+    }
+    export->managed.manager_ctx = export;
+    export->managed.deleter = dlpack_deleter;
+    Py_ssize_t count = 1;
+    for (Py_ssize_t j = 0; j < ndim; ++j) {
+        export->shape[j] = PyLong_AsLongLong(PyTuple_GET_ITEM(shape, j));
+        export->strides[j] = PyLong_AsLongLong(PyTuple_GET_ITEM(strides, j));
+        if (PyErr_Occurred()) {
+            dlpack_deleter(&export->managed);
+            return NULL;
+        }
+        count *= (Py_ssize_t)export->shape[j];
+    }
+    if (count * (bits / 8) != export->view.len) {
+        dlpack_deleter(&export->managed);
+        PyErr_SetString(PyExc_ValueError, "shape does not match the size of the buffer");
+        return NULL;
+    }
+    DLTensor *tensor = &export->managed.dl_tensor;
+    tensor->data = export->view.buf;
+    tensor->device.device_type = DL_CPU;
+    tensor->device.device_id = 0;
+    tensor->ndim = (int32_t)ndim;
+    tensor->dtype.code = (uint8_t)code;
+    tensor->dtype.bits = (uint8_t)bits;
+    tensor->dtype.lanes = 1;
+    tensor->shape = export->shape;
+    tensor->strides = export->strides;
+    tensor->byte_offset = 0;
+    PyObject *capsule = PyCapsule_New(&export->managed, "dltensor", dlpack_capsule_destructor);
+    if (capsule == NULL) {
+        dlpack_deleter(&export->managed);
+    }
+    return capsule;
+}
+
+static PyObject *native_set_engine(PyObject *self, PyObject *args) {
+    int fixed;
+    if (!PyArg_ParseTuple(args, "p:set_engine", &fixed)) {
+        return NULL;
+    }
+    fixed_engine = fixed;
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef native_methods[] = {
+    {"vdc", native_vdc, METH_VARARGS,
+     "vdc(k, base=2)\n--\n\nVan der Corput sequence (compiled version of lds.vdc)."},
+    {"vdc_i", native_vdc_i, METH_VARARGS,
+     "vdc_i(k, base=2, scale=10, factor=base**scale)\n--\n\nVan der Corput sequence, integer "
+     "version (compiled version of ilds.vdc_i and ilds._vdc_i)."},
+    {"set_engine", native_set_engine, METH_VARARGS,
+     "set_engine(fixed)\n--\n\n"
+     "Select the fixed-point (True) or the floating-point (False) radical inverses of the "
+     "batch kernels (see lds.set_engine)."},
+    {"vdc_fill", native_vdc_fill, METH_VARARGS,
+     "vdc_fill(out, start, step, base)\n--\n\n"
+     "Store vdc(start + i * step, base) into the float64 or float32 buffer out."},
+    {"vdc_i_fill", native_vdc_i_fill, METH_VARARGS,
+     "vdc_i_fill(out, start, step, base, scale)\n--\n\n"
+     "Store vdc_i(start + i * step, base, scale) into the unsigned integer buffer out."},
+    {"circle_fill", native_circle_fill, METH_VARARGS,
+     "circle_fill(x, y, start, step, base)\n--\n\n"
+     "Store the Circle points of the vdc arguments start + i * step into two columns."},
+    {"circle_table_fill", native_circle_table_fill, METH_VARARGS,
+     "circle_table_fill(x, y, lo_sin, lo_cos, start, step, base)\n--\n\n"
+     "Store the Circle points of the vdc arguments start + i * step into two columns, "
+     "combining the angle tables lo_sin and lo_cos by angle addition."},
+    {"sphere_table_fill", native_sphere_table_fill, METH_VARARGS,
+     "sphere_table_fill(x, y, z, lo_sin, lo_cos, start, step, base0, base1)\n--\n\n"
+     "Store the Sphere points of the vdc arguments start + i * step into three columns, "
+     "using the angle tables of base1."},
+    {"sphere3hopf_table_fill", native_sphere3hopf_table_fill, METH_VARARGS,
+     "sphere3hopf_table_fill(a, b, c, d, lo_sin0, lo_cos0, lo_sin1, lo_cos1, start, step, "
+     "base0, base1, base2)\n--\n\n"
+     "Store the Sphere3Hopf points of the vdc arguments start + i * step into four columns, "
+     "using the angle tables of base0 and base1."},
+    {"sphere_fill", native_sphere_fill, METH_VARARGS,
+     "sphere_fill(x, y, z, start, step, base0, base1)\n--\n\n"
+     "Store the Sphere points of the vdc arguments start + i * step into three columns."},
+    {"sphere3hopf_fill", native_sphere3hopf_fill, METH_VARARGS,
+     "sphere3hopf_fill(a, b, c, d, start, step, base0, base1, base2)\n--\n\n"
+     "Store the Sphere3Hopf points of the vdc arguments start + i * step into four columns."},
+    {"polar_fill", native_polar_fill, METH_VARARGS,
+     "polar_fill(coord, scale, cdf, dens, start, step, base, k, norm)\n--\n\n"
+     "Store cos(theta) * scale of the SphereN polar angles theta of the vdc arguments "
+     "start + i * step into coord and multiply scale by sin(theta)."},
+    {"permute_fill", native_permute_fill, METH_VARARGS,
+     "permute_fill(out, start, step, base, perms)\n--\n\n"
+     "Store the digit-permuted van der Corput values of start + i * step into out."},
+    {"linear_fill", native_linear_fill, METH_VARARGS,
+     "linear_fill(out, start, step, base, matrix, shift)\n--\n\n"
+     "Store the linearly scrambled van der Corput values of start + i * step into out."},
+    {"store_fill", native_store_fill, METH_VARARGS,
+     "store_fill(out, values, offset, step)\n--\n\n"
+     "Store the float64 values into out[offset::step], a float64 or float32 buffer."},
+    {"kronecker_fill", native_kronecker_fill, METH_VARARGS,
+     "kronecker_fill(out, x0, delta)\n--\n\n"
+     "Store the Kronecker values of the 64-bit fixed-point coordinates x0 + i * delta "
+     "into out."},
+    {"warnock_sums", native_warnock_sums, METH_VARARGS,
+     "warnock_sums(out, a, b, dim)\n--\n\n"
+     "Add the sums over the points x of a of prod(1 - max(x, y)) for the points y of b "
+     "to out."},
+    {"warnock_linear", native_warnock_linear, METH_VARARGS,
+     "warnock_linear(a, dim)\n--\n\n"
+     "Return the sum over the points x of a of prod(1 - x**2)."},
+    {"dlpack", native_dlpack, METH_VARARGS,
+     "dlpack(obj, shape, strides, code, bits)\n--\n\n"
+     "Export the writable C-contiguous buffer obj as a DLPack capsule of a CPU tensor."},
+    {NULL, NULL, 0, NULL},
+};
+
+static struct PyModuleDef native_module = {
+    PyModuleDef_HEAD_INIT, "_native", "Compiled kernels of lds_gen.", -1, native_methods,
+    NULL, NULL, NULL, NULL,
+};
+
+PyMODINIT_FUNC PyInit__native(void) { return PyModule_Create(&native_module); }
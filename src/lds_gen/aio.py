@@ -0,0 +1,220 @@
+"""
+This module contains an asyncio interface to the sequence generators with background prefetch
+
+An `AsyncPoints` wraps a generator for coroutines: `async for pt in points` yields the points
+one by one and `await points.take(n)` returns a block of `n` points. The points are generated
+block by block with the random-access `fill(out, start=...)` of `base.SequenceGenerator` in an
+executor (a thread by default, where the compiled kernels run without the GIL, or e.g. a
+`ProcessPoolExecutor`), while the event loop hands out the points of the blocks already made.
+At most `prefetch` finished blocks wait in a bounded queue, so a producer that runs ahead of
+its consumers blocks until they catch up, and a large `take()` only copies finished blocks
+between awaits instead of stalling the event loop for the whole request.
+
+The points are those that `pop()` returns after `reseed(start)`; the wrapped generator itself is
+not changed.
+"""
+
+import asyncio
+from concurrent.futures import Executor
+from typing import Any, Optional, Tuple
+
+from .base import layout
+from .block import PointBlock, _block
+
+
+def _shape(n: int, dim: int) -> Tuple[int, ...]:
+    return (n, dim) if dim > 1 else (n,)
+
+
+def _generate(gen, lo: int, hi: int) -> PointBlock:
+    """The block of the points with the indices `lo` to `hi`"""
+    dim, typecode = layout(gen)
+    res = PointBlock(typecode, _shape(hi - lo, dim))
+    gen.fill(res, start=lo)
+    return res
+
+
+class AsyncPoints:
+    """Asynchronous iterator over the points of a generator
+
+    Examples:
+        >>> from lds_gen.lds import Circle
+        >>> async def main():
+        ...     async with AsyncPoints(Circle(2), block_size=2) as points:
+        ...         first = await points.__anext__()
+        ...         rest = await points.take(2)
+        ...     return first, rest.shape
+        >>> asyncio.run(main())
+        ([1.2246467991473532e-16, -1.0], (2, 2))
+    """
+
+    def __init__(
+        self,
+        gen,
+        start: int = 0,
+        stop: Optional[int] = None,
+        block_size: int = 4096,
+        prefetch: int = 2,
+        executor: Optional[Executor] = None,
+    ) -> None:
+        """
+        The function wraps the generator `gen`; the production starts with the first request.
+
+        :param gen: The `gen` parameter is a `base.SequenceGenerator`
+
+        :param start: The `start` parameter is the index of the first point, as passed to
+        `reseed()`, defaults to 0
+
+        :type start: int (optional)
+
+        :param stop: The `stop` parameter is the index after the last point, defaults to None
+        (no end)
+
+        :type stop: int (optional)
+
+        :param block_size: The `block_size` parameter is the number of points generated per
+        executor call, defaults to 4096
+
+        :type block_size: int (optional)
+
+        :param prefetch: The `prefetch` parameter is the maximum number of finished blocks
+        waiting to be consumed, defaults to 2
+
+        :type prefetch: int (optional)
+
+        :param executor: The `executor` parameter runs the block generation, defaults to the
+        default executor of the event loop
+
+        :type executor: concurrent.futures.Executor (optional)
+        """
+        if block_size < 1 or prefetch < 1:
+            raise ValueError("block_size and prefetch must be positive")
+        self.dim, self._typecode = layout(gen)
+        self._gen = gen
+        self._start = start
+        self._stop = stop
+        self._block_size = block_size
+        self._prefetch = prefetch
+        self._executor = executor
+        self._queue: Optional[asyncio.Queue] = None
+        self._producer: Optional[asyncio.Task] = None
+        self._block: Optional[PointBlock] = None
+        self._pos = 0
+        self._done = False
+
+    async def _produce(self) -> None:
+        """Generate the blocks in order and queue them, waiting while the queue is full"""
+        assert self._queue is not None
+        loop = asyncio.get_running_loop()
+        lo = self._start
+        try:
+            while self._stop is None or lo < self._stop:
+                hi = lo + self._block_size
+                if self._stop is not None:
+                    hi = min(hi, self._stop)
+                res = await loop.run_in_executor(
+                    self._executor, _generate, self._gen, lo, hi
+                )
+                await self._queue.put(res)
+                lo = hi
+        except asyncio.CancelledError:
+            raise
+        except BaseException as exc:
+            await self._queue.put(exc)
+            return
+        await self._queue.put(None)
+
+    async def _fetch(self) -> bool:
+        """Make the next block current; False at the end of the points"""
+        if self._done:
+            return False
+        if self._producer is None:
+            self._queue = asyncio.Queue(self._prefetch)
+            self._producer = asyncio.ensure_future(self._produce())
+        assert self._queue is not None
+        item = await self._queue.get()
+        if item is None or isinstance(item, BaseException):
+            self._done = True
+            self._block = None
+            if item is not None:
+                raise item
+            return False
+        self._block, self._pos = item, 0
+        return True
+
+    def _available(self) -> int:
+        """Number of points left in the current block"""
+        if self._block is None:
+            return 0
+        return len(self._block) // self.dim - self._pos
+
+    async def take(self, n: int) -> PointBlock:
+        """
+        The `take()` function returns the next `n` points as a block of shape `(n, dim)` (or
+        `(n,)` if `dim == 1`).
+
+        A block of fewer points is returned at `stop`.
+
+        :param n: The parameter `n` is the number of points
+
+        :type n: int
+        """
+        dim = self.dim
+        res = PointBlock(self._typecode, _shape(n, dim))
+        out = memoryview(res)
+        done = 0
+        while done < n:
+            if self._available() == 0:
+                if not await self._fetch():
+                    return _block(res[: done * dim], _shape(done, dim))
+                continue
+            assert self._block is not None
+            count = min(n - done, self._available())
+            lo = self._pos * dim
+            out[done * dim : (done + count) * dim] = memoryview(self._block)[
+                lo : lo + count * dim
+            ]
+            self._pos += count
+            done += count
+            if done < n:
+                await asyncio.sleep(0)
+        return res
+
+    def __aiter__(self) -> "AsyncPoints":
+        return self
+
+    async def __anext__(self) -> Any:
+        while self._available() == 0:
+            if not await self._fetch():
+                raise StopAsyncIteration
+        assert self._block is not None
+        i = self._pos * self.dim
+        self._pos += 1
+        if self.dim == 1:
+            return self._block[i]
+        return self._block[i : i + self.dim].tolist()
+
+    async def aclose(self) -> None:
+        """
+        The `aclose()` function stops the production; no point is returned afterwards.
+        """
+        self._done = True
+        self._block = None
+        if self._producer is not None:
+            self._producer.cancel()
+            try:
+                await self._producer
+            except asyncio.CancelledError:
+                pass
+
+    async def __aenter__(self) -> "AsyncPoints":
+        return self
+
+    async def __aexit__(self, *exc_info) -> None:
+        await self.aclose()
+
+
+if __name__ == "__main__":
+    import doctest
+
+    doctest.testmod()
@@ -0,0 +1,64 @@
+"""
+This module contains the protocol shared by all sequence generators
+
+Every generator of the package (`lds`, `ilds`, `scrambled`, `sobol`, `sphere_n`, `kronecker`
+and `product`) implements `SequenceGenerator`: it declares the number of coordinates `dim` of its
+points and the `array` typecode `dtype` of its batch output, steps with `pop()`, jumps with
+`reseed()`, and computes any point directly with `at()` and any block of points with
+`fill(out, start=...)`. Since every point depends on its index only, layers built on this
+protocol (`parallel.generate_parallel()`, `cache.PointCache`, `shared.PointProducer`) work with
+every generator and reproduce the sequential results exactly.
+"""
+
+from typing import Any, Optional, Protocol, Tuple, runtime_checkable
+
+
+@runtime_checkable
+class SequenceGenerator(Protocol):
+    """Protocol of the sequence generators
+
+    `isinstance()` checks that all members are present.
+
+    Examples:
+        >>> from lds_gen import ilds, lds
+        >>> isinstance(lds.Sphere([2, 3]), SequenceGenerator)
+        True
+        >>> [(gen.dim, gen.dtype) for gen in [lds.VdCorput(2), ilds.Halton([2, 3], [11, 7])]]
+        [(1, 'd'), (2, 'H')]
+    """
+
+    # Number of coordinates of a point; generators with `dim == 1` return scalars
+    dim: int
+    # `array` typecode of the batch output, None if the values do not fit into 64 bits
+    dtype: Optional[str]
+
+    def pop(self) -> Any:
+        """The next point of the sequence"""
+
+    def reseed(self, seed: int) -> None:
+        """Continue the sequence at the index `seed`"""
+
+    def at(self, index: int) -> Any:
+        """The point that `pop()` returns right after `reseed(index)`"""
+
+    def fill(self, out, start: Optional[int] = None) -> None:
+        """Write `len(out) // dim` points in row-major order into the buffer `out`: the next
+        ones, or those from the index `start` on (passed by keyword) without changing the
+        state"""
+
+
+def layout(gen) -> Tuple[int, str]:
+    """
+    The `layout()` function returns the dimension and the `array` typecode of the batch output
+    of a generator.
+
+    Examples:
+        >>> from lds_gen.lds import HaltonN
+        >>> layout(HaltonN(3, [2, 3, 5]))
+        (3, 'd')
+    """
+    if not isinstance(gen, SequenceGenerator):
+        raise TypeError(f"{type(gen).__name__} is not a SequenceGenerator")
+    if gen.dtype is None:
+        raise OverflowError("base**scale does not fit into 64 bits")
+    return gen.dim, gen.dtype
@@ -0,0 +1,165 @@
+"""
+This module contains the result type of the batch functions
+
+A `PointBlock` is an `array.array` that also records the shape `(n, dim)` of the points it
+holds (or `(n,)` for the values of a one-dimensional sequence) and their layout, "C" (row-major)
+or "F" (column-major). Other libraries can use its memory without copying:
+
+- the buffer protocol exports the flat values, e.g. `memoryview(block)`,
+  `numpy.asarray(block).reshape(block.shape, order=block.order)` or `pyarrow.py_buffer(block)`;
+- `view()` returns a memoryview with the shape of the points;
+- DLPack (`__dlpack__` and `__dlpack_device__`) exports the shaped tensor to
+  `numpy.from_dlpack()`, `torch.from_dlpack()`, `jax.dlpack.from_dlpack()` and others.
+
+All of them share the memory of the block, which stays alive as long as any of them does, and
+writes through one are seen by all. A block cannot be resized while its memory is exported. The
+DLPack export needs the compiled extension `lds_gen._native`.
+
+Callers that manage their own memory pass it to the `fill()` functions of the generators instead.
+"""
+
+from array import array
+from typing import Optional, Tuple
+
+try:
+    from . import _native
+except ImportError:  # pragma: no cover
+    _native = None
+
+# DLPack device type and data type codes
+_DL_CPU = 1
+_DL_INT = 0
+_DL_UINT = 1
+_DL_FLOAT = 2
+
+
+class PointBlock(array):
+    """A flat array of points with their shape
+
+    Slices and copies of a block are plain arrays; a resized block is one-dimensional.
+
+    Examples:
+        >>> block = PointBlock("d", (2, 3))
+        >>> block.shape, len(block)
+        ((2, 3), 6)
+        >>> block[4] = 0.5
+        >>> block.view().tolist()
+        [[0.0, 0.0, 0.0], [0.0, 0.5, 0.0]]
+        >>> block.__dlpack_device__()
+        (1, 0)
+    """
+
+    _shape: Optional[Tuple[int, ...]] = None
+    order = "C"
+
+    def __new__(cls, typecode: str, shape: Tuple[int, ...], order: str = "C"):
+        """
+        The function allocates a zero-filled block.
+
+        :param typecode: The `typecode` parameter is the `array` typecode of the values
+
+        :type typecode: str
+
+        :param shape: The `shape` parameter is `(n, dim)` for `n` points of `dim` coordinates, or
+        `(n,)` for `n` values
+
+        :type shape: Tuple[int, ...]
+
+        :param order: The `order` parameter is the layout of the points, "C" (row-major) or "F"
+        (column-major), defaults to "C"
+
+        :type order: str (optional)
+        """
+        if order not in ("C", "F"):
+            raise ValueError(f"order must be 'C' or 'F', got {order!r}")
+        shape = tuple(shape)
+        if len(shape) not in (1, 2) or min(shape) < 0:
+            raise ValueError(f"invalid shape {shape!r}")
+        size = array(typecode).itemsize * _size(shape)
+        self = super().__new__(cls, typecode, bytes(size))
+        self._shape = shape
+        self.order = order
+        return self
+
+    @property
+    def shape(self) -> Tuple[int, ...]:
+        """The shape of the points, `(len(self),)` if the block was resized"""
+        shape = self._shape
+        if shape is None or _size(shape) != len(self):
+            return (len(self),)
+        return shape
+
+    @property
+    def strides(self) -> Tuple[int, ...]:
+        """The distance, in items, between neighbouring values along each axis"""
+        shape = self.shape
+        if len(shape) == 1:
+            return (1,)
+        return (shape[1], 1) if self.order == "C" else (1, shape[0])
+
+    def view(self) -> memoryview:
+        """
+        The `view()` function returns a memoryview of the block with the shape of its points,
+        `shape` for "C" order and the transposed `(dim, n)` for "F" order. The view of an empty
+        block is flat.
+        """
+        if len(self) == 0:
+            return memoryview(self)
+        shape = self.shape if self.order == "C" else self.shape[::-1]
+        return memoryview(self).cast("B").cast(self.typecode, shape)
+
+    def __reduce_ex__(self, protocol):
+        """Pickle the block with its shape and layout, for every pickle protocol"""
+        return _rebuild, (self.typecode, self.shape, self.order, self.tobytes())
+
+    def __dlpack__(self, *, stream=None, max_version=None, dl_device=None, copy=None):
+        """
+        The `__dlpack__()` function exports the block as a DLPack capsule of a CPU tensor with
+        `shape` and `strides`, sharing its memory unless `copy` is true.
+        """
+        if stream is not None:
+            raise ValueError("stream must be None for CPU memory")
+        if dl_device is not None and tuple(dl_device) != self.__dlpack_device__():
+            raise BufferError("a point block lives in CPU memory")
+        if copy:
+            block = PointBlock(self.typecode, self.shape, self.order)
+            memoryview(block)[:] = memoryview(self)
+            return block.__dlpack__()
+        if _native is None:
+            raise BufferError("the DLPack export needs the compiled extension")
+        if self.typecode in "fd":
+            code = _DL_FLOAT
+        else:
+            code = _DL_UINT if self.typecode.isupper() else _DL_INT
+        return _native.dlpack(self, self.shape, self.strides, code, 8 * self.itemsize)
+
+    def __dlpack_device__(self) -> Tuple[int, int]:
+        """The DLPack device of the block: `(1, 0)`, the CPU"""
+        return (_DL_CPU, 0)
+
+
+def _size(shape: Tuple[int, ...]) -> int:
+    """The number of values of a block of `shape`"""
+    return shape[0] * (shape[1] if len(shape) == 2 else 1)
+
+
+def _rebuild(
+    typecode: str, shape: Tuple[int, ...], order: str, data: bytes
+) -> PointBlock:
+    """The block of an unpickled `PointBlock`"""
+    block = PointBlock(typecode, shape, order)
+    memoryview(block).cast("B")[:] = data
+    return block
+
+
+def _block(values: array, shape: Optional[Tuple[int, ...]] = None) -> PointBlock:
+    """The values of the array `values` copied into a block of `shape` (flat by default)"""
+    block = PointBlock(values.typecode, (len(values),) if shape is None else shape)
+    memoryview(block)[:] = memoryview(values)
+    return block
+
+
+if __name__ == "__main__":
+    import doctest
+
+    doctest.testmod()
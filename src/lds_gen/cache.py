@@ -0,0 +1,301 @@
+"""
+This module contains a persistent, memory-mapped cache of generated point sets
+
+Every generator configuration (its class and parameters, but not its position) has one file in
+the cache directory. The file holds the points of one contiguous index range in row-major order
+after a small versioned header. Requests inside the cached range are served by a read-only
+memory map without copying, so that all processes of a node share the same pages; requests
+reaching beyond it first extend the file. Extending at the end appends in place, extending at the
+front rewrites the file under a new name and atomically replaces it, which leaves existing
+mappings valid.
+
+Writers hold an exclusive `fcntl` lock on the file where that is available (POSIX); the header
+is updated only after the new points have been written, so readers never see a half-written
+range.
+"""
+
+import hashlib
+import mmap
+import os
+import struct
+import tempfile
+from array import array
+from typing import Any, Optional, Tuple
+
+from . import __version__
+from .base import layout
+from .lds import get_engine
+from .parallel import generate_parallel
+
+try:
+    import fcntl
+except ImportError:  # pragma: no cover
+    fcntl = None  # type: ignore
+
+FORMAT_VERSION = 1
+
+_MAGIC = b"LDSGENPC"
+# magic, format version, dim, item size, typecode, start, stop, key digest
+_HEADER = struct.Struct("<8sIII1s3xQQ32s")
+_DATA_OFFSET = 128
+
+# Attributes holding the position of a generator rather than its parameters
+_STATE = frozenset(["count", "_count", "_x", "_digits", "_value", "_terms", "_deltas"])
+
+# Number of points generated per block while extending a cache file
+_BLOCK = 2**16
+
+
+def _params(obj: Any) -> Any:
+    """A canonical description of the parameters of a generator"""
+    if obj is None or isinstance(obj, (bool, int, float, str)):
+        return obj
+    if isinstance(obj, (list, tuple)):
+        return [_params(x) for x in obj]
+    if isinstance(obj, array):
+        return [obj.typecode, obj.tolist()]
+    cls = type(obj)
+    attrs = sorted((k, _params(v)) for k, v in vars(obj).items() if k not in _STATE)
+    return [f"{cls.__module__}.{cls.__qualname__}", attrs]
+
+
+def cache_key(gen) -> bytes:
+    """
+    The `cache_key()` function returns the digest identifying the point set of `gen`.
+
+    It covers the generator class, its bases, scales and other parameters, the engine of
+    `lds.set_engine()` and the library version, but not the current position of `gen`.
+
+    Examples:
+        >>> from lds_gen.lds import HaltonN
+        >>> gen = HaltonN(2, [2, 3])
+        >>> key = cache_key(gen)
+        >>> _ = gen.pop()
+        >>> cache_key(gen) == key, cache_key(HaltonN(2, [2, 5])) == key
+        (True, False)
+    """
+    desc = repr([FORMAT_VERSION, __version__, get_engine(), _params(gen)])
+    return hashlib.sha256(desc.encode()).digest()
+
+
+class PointCache:
+    """Memory-mapped on-disk cache of point sets
+
+    Examples:
+        >>> import tempfile
+        >>> from lds_gen.lds import HaltonN
+        >>> cache = PointCache(tempfile.mkdtemp())
+        >>> pts = cache.get(HaltonN(2, [2, 3]), 0, 2)
+        >>> pts.tolist()
+        [0.5, 0.3333333333333333, 0.25, 0.6666666666666666]
+        >>> pts.readonly
+        True
+    """
+
+    directory: str
+
+    def __init__(self, directory: str) -> None:
+        """
+        The function initializes the cache in `directory`, which is created if necessary.
+
+        :param directory: The `directory` parameter is the path of the cache directory
+
+        :type directory: str
+        """
+        self.directory = directory
+        os.makedirs(directory, exist_ok=True)
+
+    def path(self, gen) -> str:
+        """
+        The `path()` function returns the path of the cache file of `gen`.
+        """
+        return os.path.join(self.directory, cache_key(gen).hex()[:32] + ".ldspc")
+
+    def get(
+        self, gen, start: int, stop: int, workers: Optional[int] = None
+    ) -> memoryview:
+        """
+        The `get()` function returns the points `slice(start, stop)` of `gen`.
+
+        The result is a flat, read-only memoryview of `(stop - start) * dim` values in row-major
+        order (float64 for the `lds` generators, the generator's `typecode` for the `ilds`
+        generators) backed by a memory map of the cache file. Missing points are generated and
+        stored first, so that the cached range grows to cover `[start, stop)`; the state of `gen`
+        is not changed.
+
+        :param gen: The `gen` parameter is a `base.SequenceGenerator`
+
+        :param start: The `start` parameter is the index of the first point
+
+        :type start: int
+
+        :param stop: The `stop` parameter is the index after the last point
+
+        :type stop: int
+
+        :param workers: The `workers` parameter, when given, generates missing points with
+        `generate_parallel()` on that many processes
+
+        :type workers: int (optional)
+        """
+        if not 0 <= start <= stop:
+            raise ValueError("the index range must satisfy 0 <= start <= stop")
+        key = cache_key(gen)
+        dim, typecode = layout(gen)
+        if start == stop:
+            return memoryview(array(typecode)).toreadonly()
+        path = self.path(gen)
+        view = self._map(path, key, dim, typecode, start, stop)
+        if view is None:
+            self._extend(gen, path, key, start, stop, workers)
+            view = self._map(path, key, dim, typecode, start, stop)
+            if view is None:  # pragma: no cover
+                raise OSError(f"cache file {path} was modified concurrently")
+        return view
+
+    def clear(self) -> None:
+        """
+        The `clear()` function removes all cache files.
+        """
+        for name in os.listdir(self.directory):
+            if name.endswith(".ldspc"):
+                os.remove(os.path.join(self.directory, name))
+
+    @staticmethod
+    def _header(file, key: bytes, dim: int, typecode: str) -> Optional[Tuple[int, int]]:
+        """The cached index range of an open cache file, or None if it does not match"""
+        file.seek(0)
+        data = file.read(_HEADER.size)
+        if len(data) < _HEADER.size:
+            return None
+        magic, version, fdim, itemsize, code, lo, hi, fkey = _HEADER.unpack(data)
+        expected = (_MAGIC, FORMAT_VERSION, dim, array(typecode).itemsize)
+        if (magic, version, fdim, itemsize) != expected or code.decode() != typecode:
+            return None
+        if fkey != key or lo > hi:
+            return None
+        return lo, hi
+
+    def _map(
+        self, path: str, key: bytes, dim: int, typecode: str, start: int, stop: int
+    ) -> Optional[memoryview]:
+        """The points `slice(start, stop)` mapped from the cache file, or None if they are
+        not cached"""
+        try:
+            file = open(path, "rb")
+        except FileNotFoundError:
+            return None
+        with file:
+            _lock(file, shared=True)
+            cached = self._header(file, key, dim, typecode)
+            if cached is None or start < cached[0] or stop > cached[1]:
+                return None
+            mapped = mmap.mmap(file.fileno(), 0, access=mmap.ACCESS_READ)
+            # the map holds a duplicate of the descriptor, and with it the lock
+            _unlock(file)
+        row = dim * array(typecode).itemsize
+        begin = _DATA_OFFSET + (start - cached[0]) * row
+        return memoryview(mapped)[begin : begin + (stop - start) * row].cast(typecode)
+
+    def _extend(
+        self, gen, path: str, key: bytes, start: int, stop: int, workers: Optional[int]
+    ) -> None:
+        """Extend the cache file of `gen` to cover the points `slice(start, stop)`"""
+        dim, typecode = layout(gen)
+        row = dim * array(typecode).itemsize
+        with _open_locked(path) as file:
+            cached = self._header(file, key, dim, typecode)
+            if cached is not None and cached[0] <= start:
+                lo, hi = cached
+                if stop <= hi:
+                    return
+                # append in place, then publish the new range in the header
+                file.seek(_DATA_OFFSET + (hi - lo) * row)
+                file.truncate()
+                _generate(gen, file, hi, stop, typecode, dim, workers)
+                file.flush()
+                file.seek(0)
+                file.write(_pack(key, dim, typecode, lo, stop))
+                file.flush()
+                return
+            lo, hi = start, stop
+            if cached is not None:
+                hi = max(stop, cached[1])
+            fd, tmp = tempfile.mkstemp(dir=self.directory, suffix=".tmp")
+            try:
+                with os.fdopen(fd, "wb") as out:
+                    out.write(_pack(key, dim, typecode, lo, hi))
+                    if cached is None:
+                        _generate(gen, out, lo, hi, typecode, dim, workers)
+                    else:
+                        _generate(gen, out, lo, cached[0], typecode, dim, workers)
+                        file.seek(_DATA_OFFSET)
+                        _copy(file, out, (cached[1] - cached[0]) * row)
+                        _generate(gen, out, cached[1], hi, typecode, dim, workers)
+                os.replace(tmp, path)
+            except BaseException:
+                os.remove(tmp)
+                raise
+
+
+def _pack(key: bytes, dim: int, typecode: str, lo: int, hi: int) -> bytes:
+    """The header of a cache file holding the points `slice(lo, hi)`, padded to the data"""
+    itemsize = array(typecode).itemsize
+    header = _HEADER.pack(
+        _MAGIC, FORMAT_VERSION, dim, itemsize, typecode.encode(), lo, hi, key
+    )
+    return header + bytes(_DATA_OFFSET - len(header))
+
+
+def _lock(file, shared: bool = False) -> None:
+    """Lock `file` until it is closed (where `fcntl` is available)"""
+    if fcntl is not None:
+        fcntl.flock(file.fileno(), fcntl.LOCK_SH if shared else fcntl.LOCK_EX)
+
+
+def _unlock(file) -> None:
+    """Release the lock on `file` (where `fcntl` is available)"""
+    if fcntl is not None:
+        fcntl.flock(file.fileno(), fcntl.LOCK_UN)
+
+
+def _open_locked(path: str):
+    """Open (or create) the file at `path` for update, holding its exclusive lock"""
+    while True:
+        file = os.fdopen(os.open(path, os.O_RDWR | os.O_CREAT, 0o644), "r+b")
+        _lock(file)
+        try:
+            if os.path.samestat(os.fstat(file.fileno()), os.stat(path)):
+                return file
+        except FileNotFoundError:
+            pass
+        # another process replaced the file while we were waiting for the lock
+        file.close()
+
+
+def _generate(gen, out, lo: int, hi: int, typecode: str, dim: int, workers) -> None:
+    """Write the points `slice(lo, hi)` of `gen` to the file `out`"""
+    if workers is not None and hi > lo:
+        out.write(generate_parallel(gen, hi - lo, workers, start=lo))
+        return
+    itemsize = array(typecode).itemsize
+    for begin in range(lo, hi, _BLOCK):
+        n = min(_BLOCK, hi - begin)
+        block = array(typecode, bytes(itemsize * n * dim))
+        gen.fill(block, start=begin)
+        out.write(block)
+
+
+def _copy(src, dst, size: int) -> None:
+    while size > 0:
+        data = src.read(min(size, 2**24))
+        if not data:
+            raise OSError("cache file is truncated")
+        dst.write(data)
+        size -= len(data)
+
+
+if __name__ == "__main__":
+    import doctest
+
+    doctest.testmod()
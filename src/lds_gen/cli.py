@@ -0,0 +1,391 @@
+"""
+This module contains the ``lds-gen`` command, which streams the points of a generator
+
+The command computes the points ``start .. start + count - 1`` of a generator block by block
+with the random-access ``fill(out, start=...)`` of `base.SequenceGenerator`, so the batch
+kernels (compiled where available) write every block directly into its output buffer, and
+writes each block with a single call. With ``--threads`` the blocks are computed on a thread
+pool, where the compiled kernels run without the GIL, and written in order. At most two blocks
+per thread are held in memory.
+
+Three formats are available:
+
+- ``bin``: the raw coordinates, little-endian, row-major (``count * dim`` values);
+- ``npy``: the same values behind a NumPy ``.npy`` header of shape ``(count, dim)`` (or
+  ``(count,)`` for ``vdcorput``), for ``numpy.load()`` or ``numpy.memmap()``;
+- ``csv``: one point per line, the values in their shortest round-trip decimal form.
+
+Examples::
+
+    lds-gen haltonn --dim 5 --count 1000000 > points.bin
+    lds-gen sphere --base 2 3 --start 1000 --count 10 --format csv
+    lds-gen sobol --dim 8 --count 100000000 --float32 --threads 8 -o points.npy -f npy
+
+The bases default to the first primes. The command is installed with the package; ``python -m
+lds_gen.cli`` runs it as well.
+"""
+
+import argparse
+import logging
+import os
+import struct
+import sys
+from array import array
+from collections import deque
+from concurrent.futures import ThreadPoolExecutor
+from contextlib import contextmanager
+from typing import BinaryIO, Iterator, List, Optional
+
+from lds_gen import __version__
+
+from .base import layout
+from .block import PointBlock
+from .kronecker import Kronecker
+from .lds import Circle, Halton, HaltonN, Sphere, Sphere3Hopf, VdCorput, primes
+from .sobol import Sobol
+from .sphere_n import SphereN
+
+__author__ = "Wai-Shing Luk"
+__copyright__ = "Wai-Shing Luk"
+__license__ = "MIT"
+
+_logger = logging.getLogger(__name__)
+
+FORMATS = ("bin", "npy", "csv")
+
+# Generators with a fixed dimension, and their number of bases
+_FIXED = {
+    "vdcorput": (1, 1),
+    "circle": (2, 1),
+    "halton": (2, 2),
+    "sphere": (3, 2),
+    "sphere3hopf": (4, 3),
+}
+
+# Generators of any dimension, and the number of bases of dimension `dim`
+_SIZED = {
+    "haltonn": lambda dim: dim,
+    "spheren": lambda dim: dim - 1,
+    "sobol": lambda dim: 0,
+    "kronecker": lambda dim: 0,
+}
+
+GENERATORS = tuple(_FIXED) + tuple(_SIZED)
+
+# `array` typecodes of the `npy` type descriptions
+_DESCR = {"d": "f8", "f": "f4"}
+
+
+# ---- Python API ----
+
+
+def make_generator(
+    name: str,
+    dim: Optional[int] = None,
+    base: Optional[List[int]] = None,
+    trig: str = "exact",
+):
+    """
+    The `make_generator()` function builds a generator from its command line description.
+
+    :param name: The `name` parameter is one of `GENERATORS`
+
+    :type name: str
+
+    :param dim: The `dim` parameter is the dimension, required for "haltonn", "spheren",
+    "sobol" and "kronecker", defaults to None
+
+    :type dim: int (optional)
+
+    :param base: The `base` parameter holds the bases, defaults to the first primes
+
+    :type base: List[int] (optional)
+
+    :param trig: The `trig` parameter selects the trigonometric mode, see `lds.Circle`,
+    defaults to "exact"
+
+    :type trig: str (optional)
+
+    Examples:
+        >>> make_generator("haltonn", 3).pop()
+        [0.5, 0.3333333333333333, 0.2]
+        >>> make_generator("sphere", base=[3, 2]).dim
+        3
+    """
+    if name in _FIXED:
+        fixed, count = _FIXED[name]
+        if dim is not None and dim != fixed:
+            raise ValueError(f"{name} has dimension {fixed}, not {dim}")
+        dim = fixed
+    elif name in _SIZED:
+        if dim is None or dim < (3 if name == "spheren" else 1):
+            raise ValueError(f"{name} needs a valid --dim")
+        count = _SIZED[name](dim)
+    else:
+        raise ValueError(f"unknown generator {name!r}")
+    if base is None:
+        base = primes(count)
+    if len(base) != count:
+        raise ValueError(f"{name} takes {count} bases, not {len(base)}")
+    if name == "vdcorput":
+        return VdCorput(base[0])
+    if name == "circle":
+        return Circle(base[0], trig)
+    if name == "halton":
+        return Halton(base)
+    if name in ("sphere", "sphere3hopf"):
+        return (Sphere if name == "sphere" else Sphere3Hopf)(base, trig)
+    if name == "haltonn":
+        return HaltonN(dim, base)
+    if name == "spheren":
+        return SphereN(base, trig)
+    return (Sobol if name == "sobol" else Kronecker)(dim)
+
+
+def _block(gen, lo: int, hi: int, typecode: str) -> PointBlock:
+    """The points with the indices `lo` to `hi`, little-endian"""
+    res = PointBlock(typecode, (hi - lo, gen.dim))
+    gen.fill(res, start=lo)
+    if sys.byteorder == "big":
+        res.byteswap()
+    return res
+
+
+def blocks(
+    gen,
+    start: int,
+    count: int,
+    block_size: int = 65536,
+    typecode: Optional[str] = None,
+    threads: int = 1,
+) -> Iterator[PointBlock]:
+    """
+    The `blocks()` function yields the points `start .. start + count - 1` of a generator in
+    blocks of at most `block_size` points, in order, as little-endian values.
+
+    :param threads: The `threads` parameter is the number of threads computing the blocks,
+    defaults to 1
+
+    :type threads: int (optional)
+
+    Examples:
+        >>> [b.tolist() for b in blocks(VdCorput(2), 1, 3, block_size=2, threads=2)]
+        [[0.25, 0.75], [0.125]]
+    """
+    if typecode is None:
+        typecode = layout(gen)[1]
+    stop = start + count
+    bounds = ((lo, min(lo + block_size, stop)) for lo in range(start, stop, block_size))
+    if threads <= 1:
+        for lo, hi in bounds:
+            yield _block(gen, lo, hi, typecode)
+        return
+    with ThreadPoolExecutor(threads) as pool:
+        pending: deque = deque()
+        for lo, hi in bounds:
+            if len(pending) == 2 * threads:
+                yield pending.popleft().result()
+            pending.append(pool.submit(_block, gen, lo, hi, typecode))
+        while pending:
+            yield pending.popleft().result()
+
+
+def npy_header(typecode: str, shape: tuple) -> bytes:
+    """
+    The `npy_header()` function returns the header of a version 1.0 `.npy` file of
+    little-endian values.
+
+    Examples:
+        >>> header = npy_header("d", (10, 3))
+        >>> len(header), header[10:].split(b"}")[0]
+        (128, b"{'descr': '<f8', 'fortran_order': False, 'shape': (10, 3), ")
+    """
+    descr = _DESCR.get(typecode) or f"u{array(typecode).itemsize}"
+    header = f"{{'descr': '<{descr}', 'fortran_order': False, 'shape': {shape}, }}"
+    # the magic, version and length take 10 bytes; the total is a multiple of 64
+    size = -(-(10 + len(header) + 1) // 64) * 64
+    header = header.ljust(size - 11) + "\n"
+    return b"\x93NUMPY\x01\x00" + (size - 10).to_bytes(2, "little") + header.encode()
+
+
+def _float32_repr(x: float) -> str:
+    """
+    The `_float32_repr()` function returns the shortest decimal string that rounds back to the
+    float32 value `x`, in the style of `repr()`.
+
+    Examples:
+        >>> _float32_repr(array("f", [1 / 3])[0]), _float32_repr(1.0)
+        ('0.33333334', '1.0')
+    """
+    for digits in range(1, 10):
+        res = f"{x:.{digits}g}"
+        if struct.unpack("f", struct.pack("f", float(res)))[0] == x:
+            break
+    if res.lstrip("-").isdigit():
+        res += ".0"
+    return res
+
+
+def write(
+    gen,
+    out: BinaryIO,
+    start: int,
+    count: int,
+    fmt: str = "bin",
+    block_size: int = 65536,
+    typecode: Optional[str] = None,
+    threads: int = 1,
+) -> None:
+    """
+    The `write()` function writes the points `start .. start + count - 1` of a generator to a
+    binary stream in the format `fmt`; the other parameters are those of `blocks()`.
+    """
+    dim, native = layout(gen)
+    typecode = typecode or native
+    if fmt not in FORMATS:
+        raise ValueError(f"format must be one of {FORMATS}, got {fmt!r}")
+    if fmt == "npy":
+        out.write(npy_header(typecode, (count, dim) if dim > 1 else (count,)))
+    for block in blocks(gen, start, count, block_size, typecode, threads):
+        if fmt != "csv":
+            out.write(block)
+            continue
+        if sys.byteorder == "big":
+            block.byteswap()
+        text = _float32_repr if typecode == "f" else repr
+        values = [text(x) for x in block.tolist()]
+        rows = (",".join(values[i : i + dim]) for i in range(0, len(values), dim))
+        out.write(("\n".join(rows) + "\n").encode())
+
+
+# ---- CLI ----
+
+
+@contextmanager
+def _output(path: str) -> Iterator[BinaryIO]:
+    """The binary stream of an output file, or of stdout for "-" """
+    if path != "-":
+        with open(path, "wb") as out:
+            yield out
+        return
+    out = sys.stdout.buffer
+    out.flush()
+    yield out
+    out.flush()
+
+
+def parse_args(args):
+    """Parse command line parameters
+
+    Args:
+      args (List[str]): command line parameters as list of strings
+          (for example  ``["--help"]``).
+
+    Returns:
+      :obj:`argparse.Namespace`: command line parameters namespace
+    """
+    parser = argparse.ArgumentParser(
+        prog="lds-gen", description="Stream the points of a low discrepancy sequence"
+    )
+    parser.add_argument(
+        "--version",
+        action="version",
+        version=f"lds-gen {__version__}",
+    )
+    parser.add_argument(dest="generator", choices=GENERATORS, help="sequence generator")
+    parser.add_argument("-b", "--base", type=int, nargs="+", help="bases")
+    parser.add_argument("-d", "--dim", type=int, help="dimension")
+    parser.add_argument("-s", "--start", type=int, default=0, help="first point index")
+    parser.add_argument("-n", "--count", type=int, required=True, help="points")
+    parser.add_argument("-f", "--format", choices=FORMATS, default="bin", help="format")
+    parser.add_argument("-o", "--output", default="-", help="file (default: stdout)")
+    parser.add_argument("--float32", action="store_true", help="write float32 values")
+    parser.add_argument(
+        "-j", "--threads", type=int, default=1, help="threads computing the blocks"
+    )
+    parser.add_argument(
+        "--block-size", type=int, default=65536, help="points per block and write"
+    )
+    parser.add_argument(
+        "--trig", choices=("exact", "table"), default="exact", help="trigonometric mode"
+    )
+    parser.add_argument(
+        "-v",
+        "--verbose",
+        dest="loglevel",
+        help="set loglevel to INFO",
+        action="store_const",
+        const=logging.INFO,
+    )
+    parser.add_argument(
+        "-vv",
+        "--very-verbose",
+        dest="loglevel",
+        help="set loglevel to DEBUG",
+        action="store_const",
+        const=logging.DEBUG,
+    )
+    return parser.parse_args(args)
+
+
+def setup_logging(loglevel):
+    """Setup basic logging
+
+    The messages go to ``stderr``, since ``stdout`` carries the points.
+
+    Args:
+      loglevel (int): minimum loglevel for emitting messages
+    """
+    logformat = "[%(asctime)s] %(levelname)s:%(name)s:%(message)s"
+    logging.basicConfig(
+        level=loglevel, stream=sys.stderr, format=logformat, datefmt="%Y-%m-%d %H:%M:%S"
+    )
+
+
+def main(args):
+    """Stream the points described by the command line parameters
+
+    Args:
+      args (List[str]): command line parameters as list of strings
+          (for example  ``["haltonn", "--dim", "3", "--count", "10"]``).
+    """
+    args = parse_args(args)
+    setup_logging(args.loglevel)
+    if min(args.count, args.start) < 0 or min(args.block_size, args.threads) < 1:
+        raise SystemExit("lds-gen: invalid --count, --start, --block-size or --threads")
+    try:
+        gen = make_generator(args.generator, args.dim, args.base, args.trig)
+    except ValueError as error:
+        raise SystemExit(f"lds-gen: {error}")
+    typecode = "f" if args.float32 else None
+    _logger.info("Writing %d points of %s", args.count, args.generator)
+    with _output(args.output) as out:
+        write(
+            gen,
+            out,
+            args.start,
+            args.count,
+            args.format,
+            args.block_size,
+            typecode,
+            args.threads,
+        )
+    _logger.info("Done")
+
+
+def run():
+    """Calls :func:`main` passing the CLI arguments extracted from :obj:`sys.argv`
+
+    This function is the entry point of the ``lds-gen`` console script.
+    """
+    try:
+        main(sys.argv[1:])
+    except BrokenPipeError:
+        # the reader went away, e.g. `lds-gen ... | head`: no traceback, and no second error
+        # when the interpreter flushes stdout at exit
+        os.dup2(os.open(os.devnull, os.O_WRONLY), sys.stdout.fileno())
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    run()
@@ -0,0 +1,250 @@
+"""
+This module contains the L2-star discrepancy of the generators in constant memory
+
+Warnock's formula gives the squared L2-star discrepancy of the points `x_1 .. x_n` of the unit
+cube `[0, 1]**d` as
+
+    3**-d - 2**(1 - d) / n * sum_i prod_k (1 - x_ik**2)
+          + 1 / n**2 * sum_i sum_j prod_k (1 - max(x_ik, x_jk))
+
+The points are streamed from the generator in blocks with the random-access
+`fill(out, start=...)` of `base.SequenceGenerator`, so the memory stays at a few blocks however
+many points there are, and the blocks are evaluated on several processes. `l2_star()` evaluates
+the double sum exactly, block pair by block pair, in O(n**2 * d) time; `l2_star_sampled()`
+estimates it from `samples` random points of the sequence in O(n * samples * d) time and also
+returns its standard error, which makes a million points in a hundred dimensions a matter of
+minutes. The results do not depend on the number of workers.
+"""
+
+import math
+import os
+import random
+from array import array
+from concurrent.futures import ProcessPoolExecutor
+from typing import Callable, List, NamedTuple, Optional, Tuple
+
+from .base import layout
+
+try:
+    from . import _native
+except ImportError:  # pragma: no cover
+    _native = None
+
+
+class Estimate(NamedTuple):
+    """An estimated discrepancy and the standard error of the estimate"""
+
+    value: float
+    stderr: float
+
+
+def _points(gen, lo: int, hi: int) -> array:
+    """The points with the indices `lo` to `hi`, checked to lie in the unit cube"""
+    res = array("d", bytes(8 * (hi - lo) * gen.dim))
+    gen.fill(res, start=lo)
+    if res and (min(res) < 0.0 or max(res) > 1.0):
+        raise ValueError("the points must lie in the unit cube")
+    return res
+
+
+def _sums(out: array, a: array, b: array, dim: int) -> None:
+    """Add `sum_i prod_k (1 - max(a_ik, b_jk))` to `out[j]` for every point `b_j`"""
+    if _native is not None:
+        _native.warnock_sums(out, a, b, dim)
+        return
+    for j in range(len(out)):
+        y = b[j * dim : (j + 1) * dim]
+        total = 0.0
+        for i in range(0, len(a), dim):
+            prod = 1.0
+            for k in range(dim):
+                prod *= 1.0 - max(a[i + k], y[k])
+            total += prod
+        out[j] += total
+
+
+def _linear(a: array, dim: int) -> float:
+    """`sum_i prod_k (1 - a_ik**2)`"""
+    if _native is not None:
+        return _native.warnock_linear(a, dim)
+    total = 0.0
+    for i in range(0, len(a), dim):
+        prod = 1.0
+        for k in range(dim):
+            prod *= 1.0 - a[i + k] * a[i + k]
+        total += prod
+    return total
+
+
+def _row(gen, blocks: List[Tuple[int, int]], p: int) -> Tuple[float, float]:
+    """The linear sum of block `p` and its pair sums with the blocks `q >= p`"""
+    dim = gen.dim
+    a = _points(gen, *blocks[p])
+    out = array("d", bytes(8 * (blocks[p][1] - blocks[p][0])))
+    _sums(out, a, a, dim)
+    pairs = sum(out)
+    for lo, hi in blocks[p + 1 :]:
+        out = array("d", bytes(8 * (hi - lo)))
+        _sums(out, a, _points(gen, lo, hi), dim)
+        pairs += 2.0 * sum(out)
+    return _linear(a, dim), pairs
+
+
+def _sampled(gen, lo: int, hi: int, sample: array) -> Tuple[float, array]:
+    """The linear sum of a block and its pair sums with every sample point"""
+    dim = gen.dim
+    a = _points(gen, lo, hi)
+    out = array("d", bytes(8 * (len(sample) // dim)))
+    _sums(out, a, sample, dim)
+    return _linear(a, dim), out
+
+
+def _blocks(start: int, n: int, size: int) -> List[Tuple[int, int]]:
+    return [(lo, min(lo + size, start + n)) for lo in range(start, start + n, size)]
+
+
+def _run(func: Callable, tasks: list, workers: Optional[int]) -> list:
+    """The results of `func(*task)` for every task, in order"""
+    if workers is None:
+        workers = os.cpu_count() or 1
+    if workers <= 1 or len(tasks) <= 1:
+        return [func(*task) for task in tasks]
+    with ProcessPoolExecutor(min(workers, len(tasks))) as pool:
+        futures = [pool.submit(func, *task) for task in tasks]
+        return [future.result() for future in futures]
+
+
+def _check(gen, n: int) -> int:
+    dim, typecode = layout(gen)
+    if typecode != "d":
+        raise TypeError("the discrepancy needs a generator of float64 points")
+    if n < 1:
+        raise ValueError("n must be positive")
+    return dim
+
+
+def l2_star(
+    gen,
+    n: int,
+    start: int = 0,
+    block_size: int = 1024,
+    workers: Optional[int] = None,
+) -> float:
+    """
+    The `l2_star()` function computes the L2-star discrepancy of `n` points of a generator
+    exactly with Warnock's formula.
+
+    :param gen: The `gen` parameter is a `base.SequenceGenerator` of float64 points in the unit
+    cube, e.g. `lds.HaltonN`, `sobol.Sobol` or `kronecker.Kronecker`; its state is not changed
+
+    :param n: The parameter `n` is the number of points
+
+    :type n: int
+
+    :param start: The `start` parameter is the index of the first point, as passed to `reseed()`,
+    defaults to 0
+
+    :type start: int (optional)
+
+    :param block_size: The `block_size` parameter is the number of points per block, defaults to
+    1024
+
+    :type block_size: int (optional)
+
+    :param workers: The `workers` parameter is the number of worker processes, defaults to the
+    number of CPUs
+
+    :type workers: int (optional)
+
+    Examples:
+        >>> from lds_gen.lds import VdCorput
+        >>> l2_star(VdCorput(2), 1, workers=1) == math.sqrt(1 / 12)
+        True
+    """
+    dim = _check(gen, n)
+    blocks = _blocks(start, n, block_size)
+    rows = _run(_row, [(gen, blocks, p) for p in range(len(blocks))], workers)
+    linear = math.fsum(row[0] for row in rows)
+    pairs = math.fsum(row[1] for row in rows)
+    squared = 3.0**-dim - 2.0 ** (1 - dim) / n * linear + pairs / n**2
+    return math.sqrt(max(squared, 0.0))
+
+
+def l2_star_sampled(
+    gen,
+    n: int,
+    samples: int = 256,
+    seed: Optional[int] = 0,
+    start: int = 0,
+    block_size: int = 16384,
+    workers: Optional[int] = None,
+) -> Estimate:
+    """
+    The `l2_star_sampled()` function estimates the L2-star discrepancy of `n` points of a
+    generator: the single sum of Warnock's formula is exact, the double sum is the mean over
+    `samples` points `x_j`, drawn uniformly from the `n` points, of `sum_i prod_k (1 -
+    max(x_ik, x_jk)) / n`.
+
+    :param gen: The `gen` parameter is a `base.SequenceGenerator` of float64 points in the unit
+    cube; its state is not changed
+
+    :param n: The parameter `n` is the number of points
+
+    :type n: int
+
+    :param samples: The `samples` parameter is the number of sampled points, defaults to 256
+
+    :type samples: int (optional)
+
+    :param seed: The `seed` parameter seeds the choice of the sampled points, defaults to 0
+
+    :type seed: int (optional)
+
+    :param start: The `start` parameter is the index of the first point, defaults to 0
+
+    :type start: int (optional)
+
+    :param block_size: The `block_size` parameter is the number of points per block, defaults to
+    16384
+
+    :type block_size: int (optional)
+
+    :param workers: The `workers` parameter is the number of worker processes, defaults to the
+    number of CPUs
+
+    :type workers: int (optional)
+
+    :return: The function returns an `Estimate` of the discrepancy; its standard error is that
+    of the squared discrepancy divided by twice the estimate
+
+    Examples:
+        >>> from lds_gen.lds import HaltonN
+        >>> hgen = HaltonN(2, [2, 3])
+        >>> est = l2_star_sampled(hgen, 500, samples=500, workers=1)
+        >>> abs(est.value - l2_star(hgen, 500, workers=1)) < 3 * est.stderr
+        True
+    """
+    dim = _check(gen, n)
+    if samples < 2:
+        raise ValueError("at least two samples are needed")
+    rng = random.Random(seed)
+    sample = array("d")
+    for _ in range(samples):
+        index = rng.randrange(start, start + n)
+        sample += _points(gen, index, index + 1)
+    tasks = [(gen, lo, hi, sample) for lo, hi in _blocks(start, n, block_size)]
+    parts = _run(_sampled, tasks, workers)
+    linear = math.fsum(part[0] for part in parts)
+    means = [math.fsum(col) / n for col in zip(*(part[1] for part in parts))]
+    mean = math.fsum(means) / samples
+    var = math.fsum((x - mean) ** 2 for x in means) / (samples - 1)
+    squared = max(3.0**-dim - 2.0 ** (1 - dim) / n * linear + mean, 0.0)
+    value = math.sqrt(squared)
+    stderr = math.sqrt(var / samples)
+    return Estimate(value, stderr / (2.0 * value) if value > 0.0 else math.sqrt(stderr))
+
+
+if __name__ == "__main__":
+    import doctest
+
+    doctest.testmod()
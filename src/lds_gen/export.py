@@ -0,0 +1,279 @@
+"""
+This module contains a streaming export of point sets to Arrow and Parquet
+
+`record_batches()` yields the points `start .. start + n - 1` of a generator as Arrow record
+batches of `block_size` points each, `write_parquet()` writes them as one Parquet row group per
+batch and `write_arrow()` as an Arrow IPC file or stream. The blocks are computed with the
+random-access `fill(out, start=...)` of `base.SequenceGenerator` and handed to Arrow without a
+copy (with the exception below), so the memory stays at one block however many points there
+are, and the state of the generator is not changed.
+
+Two layouts are available: "list" stores every point in one column `point` of fixed-size lists
+of `dim` values, "columns" stores the coordinates in the columns `x0 .. x{dim - 1}`. For the
+"columns" layout the generators of this library fill their blocks column-major, so that every
+column is a slice of the block; other generators of more than one dimension fill row-major only,
+and their coordinates are copied into the columns. The schema metadata records the generator
+parameters (as `cache.cache_key()` sees them), the index range, the engine of `lds.set_engine()`
+and the library version, which identifies the point set for a later audit.
+
+The export needs pyarrow (`pip install lds-gen[export]`), which is imported on first use. The
+destination is a local path, a file object, or a path on a `pyarrow.fs` filesystem such as
+`S3FileSystem` (or a URI like "s3://bucket/points.parquet" that pyarrow can resolve).
+"""
+
+import json
+from array import array
+from typing import Any, Dict, Iterator, Optional, Tuple
+
+from . import __version__, ilds
+from .base import layout
+from .block import PointBlock
+from .cache import _params, cache_key
+from .lds import _PointBatch, get_engine
+
+LAYOUTS = ("list", "columns")
+
+
+def _arrow():
+    try:
+        import pyarrow
+    except ImportError as error:
+        raise RuntimeError("the export needs pyarrow") from error
+    return pyarrow
+
+
+def metadata(gen, start: int, n: int) -> Dict[str, str]:
+    """
+    The `metadata()` function returns the schema metadata identifying a point set.
+
+    Examples:
+        >>> from lds_gen.lds import HaltonN
+        >>> meta = metadata(HaltonN(2, [2, 3]), 10, 1000)
+        >>> meta["lds_gen.start"], meta["lds_gen.count"]
+        ('10', '1000')
+    """
+    return {
+        "lds_gen.version": __version__,
+        "lds_gen.engine": get_engine(),
+        "lds_gen.generator": json.dumps(_params(gen)),
+        "lds_gen.key": cache_key(gen).hex(),
+        "lds_gen.start": str(start),
+        "lds_gen.count": str(n),
+    }
+
+
+def _check(gen, n: int, block_size: int, points: str) -> Tuple[int, str]:
+    dim, typecode = layout(gen)
+    if points not in LAYOUTS:
+        raise ValueError(f"layout must be one of {LAYOUTS}, got {points!r}")
+    if n < 0 or block_size < 1:
+        raise ValueError("n must be non-negative and block_size positive")
+    return dim, typecode
+
+
+def schema(gen, points: str = "list", meta: Optional[Dict[str, str]] = None) -> Any:
+    """
+    The `schema()` function returns the Arrow schema of the exported points of a generator.
+
+    :param gen: The `gen` parameter is a `base.SequenceGenerator`
+
+    :param points: The `points` parameter is the layout, "list" or "columns", defaults to "list"
+
+    :type points: str (optional)
+
+    :param meta: The `meta` parameter is the schema metadata, defaults to None
+    """
+    pa = _arrow()
+    dim, typecode = _check(gen, 0, 1, points)
+    size = 8 * array(typecode).itemsize
+    kind = pa.float32() if typecode == "f" else pa.float64()
+    if typecode not in "fd":
+        kind = getattr(pa, f"uint{size}")()
+    value = pa.field("item", kind, nullable=False)
+    if points == "list":
+        fields = [pa.field("point", pa.list_(value, dim), nullable=False)]
+    else:
+        fields = [value.with_name(f"x{j}") for j in range(dim)]
+    return pa.schema(fields, metadata=meta)
+
+
+def _batch(pa, gen, lo: int, hi: int, points: str, target) -> Any:
+    """The record batch of the points with the indices `lo` to `hi`"""
+    n, dim = hi - lo, gen.dim
+    if points == "list":
+        block = PointBlock(gen.dtype, (n, dim))
+        gen.fill(block, start=lo)
+        kind = target.field(0).type.value_type
+        values = pa.Array.from_buffers(kind, n * dim, [None, pa.py_buffer(block)])
+        arrays = [pa.FixedSizeListArray.from_arrays(values, dim)]
+    elif dim == 1 or isinstance(gen, (_PointBatch, ilds.Halton)):
+        # column-major, so that every column is a slice of the one buffer
+        block = PointBlock(gen.dtype, (n, dim), "F")
+        if dim == 1:
+            gen.fill(block, start=lo)
+        else:
+            gen.fill(block, "F", start=lo)
+        buf, size = pa.py_buffer(block), n * block.itemsize
+        arrays = [
+            pa.Array.from_buffers(field.type, n, [None, buf.slice(j * size, size)])
+            for j, field in enumerate(target)
+        ]
+    else:
+        # `SequenceGenerator.fill()` is row-major only: copy the columns
+        block = PointBlock(gen.dtype, (n, dim))
+        gen.fill(block, start=lo)
+        arrays = [
+            pa.Array.from_buffers(field.type, n, [None, pa.py_buffer(block[j::dim])])
+            for j, field in enumerate(target)
+        ]
+    return pa.RecordBatch.from_arrays(arrays, schema=target)
+
+
+def record_batches(
+    gen,
+    n: int,
+    start: int = 0,
+    block_size: int = 65536,
+    points: str = "list",
+) -> Iterator[Any]:
+    """
+    The `record_batches()` function yields the points `start .. start + n - 1` of a generator as
+    Arrow record batches of at most `block_size` points.
+
+    :param gen: The `gen` parameter is a `base.SequenceGenerator`; its state is not changed
+
+    :param n: The parameter `n` is the number of points
+
+    :type n: int
+
+    :param start: The `start` parameter is the index of the first point, as passed to
+    `reseed()`, defaults to 0
+
+    :type start: int (optional)
+
+    :param block_size: The `block_size` parameter is the number of points per batch, defaults
+    to 65536
+
+    :type block_size: int (optional)
+
+    :param points: The `points` parameter is the layout, "list" or "columns", defaults to "list";
+    see the module documentation for when the "columns" layout copies the coordinates
+
+    :type points: str (optional)
+    """
+    _check(gen, n, block_size, points)
+    pa = _arrow()
+    target = schema(gen, points, metadata(gen, start, n))
+    for lo in range(start, start + n, block_size):
+        yield _batch(pa, gen, lo, min(lo + block_size, start + n), points, target)
+
+
+def _sink(pa, where, filesystem):
+    """An output stream for a path, URI or file object"""
+    if not isinstance(where, str):
+        return pa.PythonFile(where, mode="w"), False
+    if filesystem is None and "://" in where:
+        from pyarrow.fs import FileSystem
+
+        filesystem, where = FileSystem.from_uri(where)
+    if filesystem is None:
+        return pa.OSFile(where, "wb"), True
+    return filesystem.open_output_stream(where), True
+
+
+def write_parquet(
+    gen,
+    where,
+    n: int,
+    start: int = 0,
+    block_size: int = 65536,
+    points: str = "list",
+    filesystem=None,
+    compression: str = "snappy",
+) -> None:
+    """
+    The `write_parquet()` function writes the points `start .. start + n - 1` of a generator to a
+    Parquet file, one row group per block.
+
+    :param gen: The `gen` parameter is a `base.SequenceGenerator`; its state is not changed
+
+    :param where: The `where` parameter is the destination: a path, a URI or a file object
+
+    :param n: The parameter `n` is the number of points
+
+    :type n: int
+
+    :param start: The `start` parameter is the index of the first point, defaults to 0
+
+    :type start: int (optional)
+
+    :param block_size: The `block_size` parameter is the number of points per row group,
+    defaults to 65536
+
+    :type block_size: int (optional)
+
+    :param points: The `points` parameter is the layout, "list" or "columns", defaults to "list"
+
+    :type points: str (optional)
+
+    :param filesystem: The `filesystem` parameter is the `pyarrow.fs` filesystem of `where`,
+    defaults to None (a local path, or the filesystem of the URI)
+
+    :param compression: The `compression` parameter is the Parquet compression codec, defaults
+    to "snappy"
+
+    :type compression: str (optional)
+    """
+    _check(gen, n, block_size, points)
+    _arrow()
+    import pyarrow.parquet as pq
+
+    target = schema(gen, points, metadata(gen, start, n))
+    with pq.ParquetWriter(
+        where, target, filesystem=filesystem, compression=compression
+    ) as writer:
+        for batch in record_batches(gen, n, start, block_size, points):
+            writer.write_batch(batch, row_group_size=block_size)
+
+
+def write_arrow(
+    gen,
+    where,
+    n: int,
+    start: int = 0,
+    block_size: int = 65536,
+    points: str = "list",
+    filesystem=None,
+    stream: bool = False,
+) -> None:
+    """
+    The `write_arrow()` function writes the points `start .. start + n - 1` of a generator in the
+    Arrow IPC format, one record batch per block.
+
+    The parameters are those of `write_parquet()`.
+
+    :param stream: The `stream` parameter selects the IPC stream format instead of the file
+    format, defaults to False
+
+    :type stream: bool (optional)
+    """
+    _check(gen, n, block_size, points)
+    pa = _arrow()
+    import pyarrow.ipc
+
+    target = schema(gen, points, metadata(gen, start, n))
+    sink, owned = _sink(pa, where, filesystem)
+    try:
+        new = pa.ipc.new_stream if stream else pa.ipc.new_file
+        with new(sink, target) as writer:
+            for batch in record_batches(gen, n, start, block_size, points):
+                writer.write_batch(batch)
+    finally:
+        if owned:
+            sink.close()
+
+
+if __name__ == "__main__":
+    import doctest
+
+    doctest.testmod()
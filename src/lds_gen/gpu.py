@@ -0,0 +1,215 @@
+"""
+This module contains an optional GPU backend of the batch generators
+
+`generate()` computes a block of points of `VdCorput`, `Halton`, `HaltonN`, `Circle`, `Sphere`
+or `Sphere3Hopf` on a CUDA device and returns a device array, `fill()` writes them into a
+caller-supplied device array. Every thread computes the radical inverses of its own index, so
+no state is shared between threads. Device arrays are exchanged through the
+`__cuda_array_interface__` protocol: CuPy, PyTorch and others wrap them without a copy (e.g.
+`cupy.asarray(res)`, which in turn exports DLPack), and `fill()` accepts their arrays as `out`.
+
+The backend needs Numba with CUDA support (`pip install lds-gen[gpu]`), which is imported on
+first use; `available()` tells whether a device can be used. The radical inverses run the digit
+loop of `lds.vdc()` in float64 and match the CPU results bit for bit with the default "float"
+engine of `lds.set_engine()` (the "fixed" engine is not available on the device). The device versions of
+`sin` and `cos` may differ from the host in the last bits, so the coordinates of `Circle`,
+`Sphere` and `Sphere3Hopf` match the CPU path within `TOLERANCE`, plus the rounding to float32
+for `dtype="f"`. The product in `1 - cosphi**2` of `Sphere` is rounded on its own, as on the host:
+fused into a multiply-add, it would shift the coordinates near the poles by about 1e-16 / sinphi. The `trig` mode of the generators is
+ignored: the device always evaluates the functions directly.
+"""
+
+from typing import Any, Dict, Tuple
+
+from . import lds
+from .lds import TWO_PI, _typecode
+
+# Largest absolute difference between a GPU and a CPU coordinate in float64
+TOLERANCE = 1e-15
+
+_THREADS_PER_BLOCK = 256
+
+# Compiled kernels, by name, filled on first use
+_kernels: Dict[str, Any] = {}
+
+
+def available() -> bool:
+    """
+    The `available()` function tells whether Numba is installed and a CUDA device is present.
+    """
+    try:
+        from numba import cuda
+    except ImportError:
+        return False
+    return bool(cuda.is_available())
+
+
+def _cuda():
+    try:
+        from numba import cuda
+    except ImportError as error:
+        raise RuntimeError("the GPU backend needs numba with CUDA support") from error
+    return cuda
+
+
+def _compile() -> Dict[str, Any]:
+    """The CUDA kernels, compiled on the first call"""
+    if _kernels:
+        return _kernels
+    import math
+
+    cuda = _cuda()
+    from numba.cuda import libdevice
+
+    @cuda.jit(device=True)
+    def vdc(k, base):
+        res = 0.0
+        denom = 1.0
+        while k != 0:
+            denom *= base
+            remainder = k % base
+            k //= base
+            res += remainder / denom
+        return res
+
+    @cuda.jit
+    def halton(out, bases, start):
+        i = cuda.grid(1)
+        if i < out.shape[0]:
+            for j in range(bases.shape[0]):
+                out[i, j] = vdc(start + i + 1, bases[j])
+
+    @cuda.jit
+    def circle(out, base, start):
+        i = cuda.grid(1)
+        if i < out.shape[0]:
+            theta = vdc(start + i + 1, base) * TWO_PI
+            out[i, 0] = math.sin(theta)
+            out[i, 1] = math.cos(theta)
+
+    @cuda.jit
+    def sphere(out, base0, base1, start):
+        i = cuda.grid(1)
+        if i < out.shape[0]:
+            k = start + i + 1
+            cosphi = 2.0 * vdc(k, base0) - 1.0
+            # a separately rounded product, not contracted into a multiply-add
+            sinphi = math.sqrt(1.0 - libdevice.dmul_rn(cosphi, cosphi))
+            theta = vdc(k, base1) * TWO_PI
+            out[i, 0] = sinphi * math.sin(theta)
+            out[i, 1] = sinphi * math.cos(theta)
+            out[i, 2] = cosphi
+
+    @cuda.jit
+    def sphere3hopf(out, base0, base1, base2, start):
+        i = cuda.grid(1)
+        if i < out.shape[0]:
+            k = start + i + 1
+            phi = vdc(k, base0) * TWO_PI
+            psy = vdc(k, base1) * TWO_PI
+            vd = vdc(k, base2)
+            cos_eta = math.sqrt(vd)
+            sin_eta = math.sqrt(1.0 - vd)
+            out[i, 0] = cos_eta * math.cos(psy)
+            out[i, 1] = cos_eta * math.sin(psy)
+            out[i, 2] = sin_eta * math.cos(phi + psy)
+            out[i, 3] = sin_eta * math.sin(phi + psy)
+
+    _kernels.update(
+        halton=halton, circle=circle, sphere=sphere, sphere3hopf=sphere3hopf
+    )
+    return _kernels
+
+
+def _plan(gen) -> Tuple[str, Tuple[int, ...]]:
+    """The kernel name and the bases of a generator"""
+    kind = type(gen)
+    if kind in (lds.VdCorput, lds.IncrementalVdCorput):
+        name, vdcs = "halton", [gen]
+    elif kind is lds.Halton:
+        name, vdcs = "halton", [gen.vdc0, gen.vdc1]
+    elif kind is lds.HaltonN:
+        name, vdcs = "halton", gen.vdcs
+    elif kind is lds.Circle:
+        name, vdcs = "circle", [gen.vdc]
+    elif kind is lds.Sphere:
+        name, vdcs = "sphere", [gen.vdc, gen.cirgen.vdc]
+    elif kind is lds.Sphere3Hopf:
+        name, vdcs = "sphere3hopf", [gen.vdc0, gen.vdc1, gen.vdc2]
+    else:
+        raise TypeError(f"{kind.__name__} has no GPU kernel")
+    if any(vdc.leap != 1 or vdc.offset != 0 for vdc in vdcs):
+        raise TypeError("the GPU kernels do not support leaped substreams")
+    return name, tuple(vdc.base for vdc in vdcs)
+
+
+def fill(gen, out, start: int = 0) -> None:
+    """
+    The `fill()` function writes the points `slice(start, start + n)` of `gen` into a device array.
+
+    The state of `gen` is not changed.
+
+    :param gen: The `gen` parameter is one of the generators listed in the module documentation
+
+    :param out: The parameter `out` is a C-contiguous float64 or float32 device array with
+    `__cuda_array_interface__` (Numba, CuPy, PyTorch, ...) of shape `(n, dim)` or `(n * dim,)`
+
+    :param start: The `start` parameter is the index of the first point, as passed to `reseed()`,
+    defaults to 0
+
+    :type start: int (optional)
+    """
+    cuda = _cuda()
+    name, bases = _plan(gen)
+    dim = gen.dim
+    view = cuda.as_cuda_array(out)
+    if view.dtype.char not in "df" or not view.is_c_contiguous():
+        raise TypeError("out must be a C-contiguous float64 or float32 device array")
+    n, rem = divmod(view.size, dim)
+    if rem != 0:
+        raise ValueError(f"output buffer size {view.size} is not a multiple of {dim}")
+    if start < 0 or start + n >= 2**63:
+        raise OverflowError("the GPU kernels need indices below 2**63")
+    if n == 0:
+        return
+    view = view.reshape(n, dim)
+    kernel = _compile()[name]
+    blocks = -(-n // _THREADS_PER_BLOCK)
+    if name == "halton":
+        import numpy
+
+        args: Tuple[Any, ...] = (cuda.to_device(numpy.array(bases, dtype=numpy.int64)),)
+    else:
+        args = bases
+    kernel[blocks, _THREADS_PER_BLOCK](view, *args, start)
+
+
+def generate(gen, n: int, start: int = 0, dtype: str = "d"):
+    """
+    The `generate()` function returns the points `slice(start, start + n)` of `gen` as a new
+    device array.
+
+    :param gen: The `gen` parameter is one of the generators listed in the module documentation
+
+    :param n: The parameter `n` is the number of points
+
+    :type n: int
+
+    :param start: The `start` parameter is the index of the first point, defaults to 0
+
+    :type start: int (optional)
+
+    :param dtype: The `dtype` parameter is "d" (float64) or "f" (float32), defaults to "d"
+
+    :type dtype: str (optional)
+
+    :return: The function `generate` returns a Numba device array of shape `(n, dim)`, or `(n,)`
+    for `VdCorput`.
+    """
+    cuda = _cuda()
+    _plan(gen)
+    code = _typecode(dtype)
+    shape = (n,) if isinstance(gen, lds.VdCorput) else (n, gen.dim)
+    out = cuda.device_array(shape, dtype="float64" if code == "d" else "float32")
+    fill(gen, out, start)
+    return out
@@ -1,4 +1,46 @@
-from typing import List, Sequence
+from array import array
+from typing import Iterator, List, Optional, Sequence
+
+from .block import PointBlock
+from .lds import _flat_view, _rows, _write_column
+from .tables import int_table
+
+try:
+    from . import _native
+except ImportError:  # pragma: no cover
+    _native = None
+
+# `array` typecodes accepted for integer output buffers
+_INT_TYPECODES = "bBhHiIlLqQ"
+
+
+def uint_typecode(limit: int) -> Optional[str]:
+    """
+    The `uint_typecode()` function returns the narrowest unsigned `array` typecode that holds the
+    integers `0 .. limit - 1`, or None if 64 bits do not suffice.
+
+    Examples:
+        >>> uint_typecode(2**16), uint_typecode(2**16 + 1), uint_typecode(2**65)
+        ('H', 'I', None)
+    """
+    for code in "BHIQ":
+        if limit <= 1 << (8 * array(code).itemsize):
+            return code
+    return None
+
+
+def _allocate(typecode: Optional[str], *shape: int, order: str = "C") -> PointBlock:
+    """A zeroed block of `typecode` with `shape`"""
+    if typecode is None:
+        raise OverflowError("base**scale does not fit into 64 bits")
+    return PointBlock(typecode, shape, order)
+
+
+def _widest(*codes: Optional[str]) -> Optional[str]:
+    """The typecode with the largest items, or None if any of them is None"""
+    if None in codes:
+        return None
+    return max(codes, key=lambda code: array(code).itemsize)
 
 
 def vdc_i(k: int, base: int = 2, scale: int = 10) -> int:
@@ -24,12 +66,33 @@ def vdc_i(k: int, base: int = 2, scale: int = 10) -> int:
 
     :return: The function `vdc_i` returns an integer value.
 
+    For base 2 the result is computed as a bit reversal of `k`; for other small bases several digits
+    are processed per step with a cached lookup table (see `lds_gen.tables`).
+
     Examples:
         >>> vdc_i(1, 2, 10)
         512
     """
+    return _vdc_i(k, base, scale, base**scale)
+
+
+def _vdc_i(k: int, base: int, scale: int, factor: int) -> int:
+    """`vdc_i()` with the precomputed `factor == base**scale` of the generators"""
+    if base == 2:
+        bits = bin(k)[:1:-1][:scale]  # lowest binary digits, least significant first
+        return int(bits, 2) << (scale - len(bits)) if bits else 0
     vdc: int = 0
-    factor: int = base**scale
+    entry = int_table(base)
+    if entry is not None:
+        table, m = entry
+        span = len(table)
+        while k != 0 and factor >= span:
+            factor //= span
+            k, low = divmod(k, span)
+            vdc += table[low] * factor
+        if k != 0 and factor > 1:
+            # fewer than `m` digits of precision left: keep the leading ones
+            return vdc + table[k % span] // (span // factor)
     while k != 0:
         factor //= base
         remainder: int = k % base
@@ -39,7 +102,11 @@ def vdc_i(k: int, base: int = 2, scale: int = 10) -> int:
 
 
 # The `VdCorput` class initializes an object with a base and scale value, and sets the count to 0.
+# Its batch output uses `typecode`, the narrowest unsigned `array` type holding `base**scale - 1`.
 class VdCorput:
+    dim = 1
+    typecode: Optional[str]
+
     def __init__(self, base: int = 2, scale: int = 10) -> None:
         """
         The function initializes an object with a base and scale value, and sets the count to 0.
@@ -58,7 +125,14 @@ class VdCorput:
         """
         self._base: int = base
         self._scale: int = scale
+        self._factor: int = base**scale
         self._count: int = 0
+        self.typecode = uint_typecode(self._factor)
+
+    @property
+    def dtype(self) -> Optional[str]:
+        """The `array` typecode of the batch output, i.e. `typecode`"""
+        return self.typecode
 
     def pop(self) -> int:
         """
@@ -73,7 +147,60 @@ class VdCorput:
             512
         """
         self._count += 1
-        return vdc_i(self._count, self._base, self._scale)
+        return _vdc_i(self._count, self._base, self._scale, self._factor)
+
+    def __iter__(self) -> "VdCorput":
+        return self
+
+    def __next__(self) -> int:
+        """
+        The `__next__()` function returns `pop()`, so that the generator can be used as an
+        (endless) iterator.
+
+        Examples:
+            >>> from itertools import islice
+            >>> list(islice(VdCorput(2, 10), 3))
+            [512, 256, 768]
+        """
+        return self.pop()
+
+    def chunks(self, chunk_size: int) -> Iterator[PointBlock]:
+        """
+        The `chunks()` function yields the sequence in consecutive blocks of `chunk_size` values.
+
+        One array of `typecode` is allocated up front and refilled for every block; the same buffer
+        object is yielded each time. The generator is endless.
+
+        Examples:
+            >>> next(VdCorput(2, 10).chunks(3)).tolist()
+            [512, 256, 768]
+        """
+        buf = _allocate(self.typecode, chunk_size)
+        while True:
+            self.fill(buf)
+            yield buf
+
+    def pop_batch(self, n: int) -> PointBlock:
+        """
+        The `pop_batch()` function generates the next `n` values in the sequence at once.
+
+        :param n: The parameter `n` is the number of values to generate
+
+        :type n: int
+
+        :return: The function `pop_batch` returns a `block.PointBlock` of `typecode`, e.g. `"H"`
+        for values below 2**16.
+
+        Examples:
+            >>> vgen = VdCorput(3, 7)
+            >>> vgen.pop_batch(3)
+            PointBlock('H', [729, 1458, 243])
+            >>> vgen.pop()
+            972
+        """
+        out = _allocate(self.typecode, n)
+        self.fill(out)
+        return out
 
     def reseed(self, seed: int) -> None:
         """
@@ -92,6 +219,172 @@ class VdCorput:
         """
         self._count = seed
 
+    def at(self, index: int) -> int:
+        """
+        The `at()` function returns the value that `pop()` returns right after `reseed(index)`.
+
+        The state of the generator is not changed.
+
+        :param index: The `index` parameter is the position in the sequence
+
+        :type index: int
+
+        Examples:
+            >>> vdc = VdCorput(2, 10)
+            >>> vdc.at(2)
+            768
+        """
+        return _vdc_i(index + 1, self._base, self._scale, self._factor)
+
+    def slice(self, start: int, stop: int, step: int = 1) -> List[int]:
+        """
+        The `slice()` function returns `at(i)` for every `i` in `range(start, stop, step)`.
+
+        This is exactly what `reseed(start)` followed by `stop - start` calls to `pop()` would return
+        (for `step == 1`), computed directly without generating the preceding values.
+
+        Examples:
+            >>> vdc = VdCorput(2, 10)
+            >>> vdc.slice(0, 3)
+            [512, 256, 768]
+        """
+        base, scale, factor = self._base, self._scale, self._factor
+        return [_vdc_i(k + 1, base, scale, factor) for k in range(start, stop, step)]
+
+    def fill(self, out, start: Optional[int] = None) -> None:
+        """
+        The `fill()` function writes `len(out)` consecutive values of the sequence into `out`.
+
+        :param out: The parameter `out` is a writable, C-contiguous buffer of integers (for example an
+        `array("Q")` or a `numpy.ndarray` of `uint64`) whose item size can hold `base**scale`.
+
+        :param start: The `start` parameter selects random access: when given, `out` receives
+        `slice(start, start + len(out))` and the state of the generator is left unchanged. By
+        default the next values are written and the count is advanced.
+
+        :type start: int (optional)
+
+        Examples:
+            >>> out = array("H", bytes(2 * 3))
+            >>> VdCorput(2, 10).fill(out)
+            >>> out.tolist()
+            [512, 256, 768]
+        """
+        view = _flat_view(out, _INT_TYPECODES)
+        n = len(view)
+        if start is None:
+            start = self._count
+            self._count += n
+        if _native is not None and view.format in "BHILQ":
+            try:
+                _native.vdc_i_fill(view, start + 1, 1, self._base, self._scale)
+                return
+            except OverflowError:
+                pass
+        view[:] = array(view.format, self.slice(start, start + n))
+
+
+class IncrementalVdCorput(VdCorput):
+    """Van der Corput sequence generator (integer version) with incremental digit update
+
+    `IncrementalVdCorput` produces exactly the same values as `VdCorput`, but
+    keeps the base-`base` digits of the count between calls. Stepping the count
+    only touches the digits affected by the carry and updates the value with a
+    single integer addition, which is amortized O(1) instead of the
+    O(log_b k) expansion done by `vdc_i`.
+
+    Examples:
+        >>> vgen = IncrementalVdCorput(3, 7)
+        >>> vgen.reseed(0)
+        >>> [vgen.pop() for _ in range(4)] == [vdc_i(k, 3, 7) for k in range(1, 5)]
+        True
+    """
+
+    def __init__(self, base: int = 2, scale: int = 10) -> None:
+        """
+        The function initializes an object with a base and scale value, and sets the count to 0.
+
+        :param base: The `base` parameter specifies the base of the number system, defaults to 2
+
+        :type base: int (optional)
+
+        :param scale: The `scale` parameter determines the number of digits kept in the result,
+        defaults to 10
+
+        :type scale: int (optional)
+        """
+        super().__init__(base, scale)
+        self._deltas: List[int] = []
+        self._digits: List[int] = []
+        self._value: int = 0
+        self.reseed(0)
+
+    def _grow(self, ndigits: int) -> None:
+        """Extend the cached carry increments to `ndigits` positions"""
+        base, scale = self._base, self._scale
+        while len(self._deltas) < ndigits:
+            i = len(self._deltas)
+            # value change when digits 0..i-1 wrap to 0 and digit i is incremented;
+            # digits beyond `scale` do not contribute to the value
+            gain = base ** (scale - 1 - i) if i < scale else 0
+            loss = self._factor - base ** (scale - i) if i < scale else self._factor - 1
+            self._deltas.append(gain - loss)
+
+    def pop(self) -> int:
+        """
+        The `pop()` function increments the count and returns the next value in the sequence.
+
+        Examples:
+            >>> vdc = IncrementalVdCorput(2, 10)
+            >>> vdc.pop()
+            512
+        """
+        digits = self._digits
+        last = self._base - 1
+        i = 0
+        while i < len(digits) and digits[i] == last:
+            digits[i] = 0
+            i += 1
+        if i == len(digits):
+            digits.append(1)
+            self._grow(i + 1)
+        else:
+            digits[i] += 1
+        self._count += 1
+        self._value += self._deltas[i]
+        return self._value
+
+    def fill(self, out, start: Optional[int] = None) -> None:
+        """
+        The `fill()` function writes `len(out)` consecutive values of the sequence into `out`.
+
+        Examples:
+            >>> vdc = IncrementalVdCorput(2, 10)
+            >>> vdc.fill(array("H", bytes(2 * 3)))
+            >>> vdc.pop()
+            128
+        """
+        super().fill(out, start)
+        if start is None:
+            self.reseed(self._count)
+
+    def reseed(self, seed: int) -> None:
+        """
+        The `reseed` function resets the state of a sequence generator to a specific seed value.
+
+        :param seed: The `seed` parameter is an integer value that is used to reset the state of the
+        sequence generator. It determines the starting point of the sequence generation
+
+        :type seed: int
+        """
+        self._count = seed
+        self._digits = []
+        while seed != 0:
+            self._digits.append(seed % self._base)
+            seed //= self._base
+        self._grow(len(self._digits))
+        self._value = _vdc_i(self._count, self._base, self._scale, self._factor)
+
 
 class Halton:
     """Halton sequence generator
@@ -122,6 +415,9 @@ class Halton:
         [640, 810]
     """
 
+    dim = 2
+    typecode: Optional[str]
+
     def __init__(self, base: Sequence[int], scale: Sequence[int]) -> None:
         """
         The `__init__()` function is a constructor for the `Halton` class that initializes two `VdCorput`
@@ -136,6 +432,12 @@ class Halton:
         """
         self._vdc0 = VdCorput(base[0], scale[0])
         self._vdc1 = VdCorput(base[1], scale[1])
+        self.typecode = _widest(self._vdc0.typecode, self._vdc1.typecode)
+
+    @property
+    def dtype(self) -> Optional[str]:
+        """The `array` typecode of the batch output, i.e. `typecode`"""
+        return self.typecode
 
     def pop(self) -> List[int]:
         """
@@ -145,6 +447,58 @@ class Halton:
         """
         return [self._vdc0.pop(), self._vdc1.pop()]
 
+    def __iter__(self) -> "Halton":
+        return self
+
+    def __next__(self) -> List[int]:
+        """
+        The `__next__()` function returns `pop()`, so that the generator can be used as an
+        (endless) iterator.
+        """
+        return self.pop()
+
+    def chunks(self, chunk_size: int, order: str = "C") -> Iterator[PointBlock]:
+        """
+        The `chunks()` function yields the sequence in consecutive blocks of `chunk_size` points.
+
+        One flat array of `typecode` with `2 * chunk_size` values is allocated up front and
+        refilled for every block; the same buffer object is yielded each time. The generator is
+        endless.
+
+        Examples:
+            >>> next(Halton([2, 3], [11, 7]).chunks(2)).tolist()
+            [1024, 729, 512, 1458]
+        """
+        buf = _allocate(self.typecode, chunk_size, 2, order=order)
+        while True:
+            self.fill(buf, order)
+            yield buf
+
+    def pop_batch(self, n: int, order: str = "C") -> PointBlock:
+        """
+        The `pop_batch()` function generates the next `n` points of the sequence at once.
+
+        :param n: The parameter `n` is the number of points to generate
+
+        :type n: int
+
+        :param order: The `order` parameter selects the layout of the result, either "C" (row-major)
+        or "F" (column-major), defaults to "C"
+
+        :type order: str (optional)
+
+        :return: The function `pop_batch` returns a `block.PointBlock` of shape `(n, 2)` and
+        `typecode`, the wider of the typecodes of the two coordinates.
+
+        Examples:
+            >>> hgen = Halton([2, 3], [11, 7])
+            >>> hgen.pop_batch(2)
+            PointBlock('H', [1024, 729, 512, 1458])
+        """
+        out = _allocate(self.typecode, n, 2, order=order)
+        self.fill(out, order)
+        return out
+
     def reseed(self, seed: int) -> None:
         """
         The `reseed` function resets the state of a sequence generator to a specific seed value.
@@ -157,6 +511,67 @@ class Halton:
         self._vdc0.reseed(seed)
         self._vdc1.reseed(seed)
 
+    def at(self, index: int) -> List[int]:
+        """
+        The `at()` function returns the point that `pop()` returns right after `reseed(index)`.
+
+        Examples:
+            >>> hgen = Halton([2, 3], [11, 7])
+            >>> hgen.at(1)
+            [512, 1458]
+        """
+        return [self._vdc0.at(index), self._vdc1.at(index)]
+
+    def slice(self, start: int, stop: int, step: int = 1) -> List[List[int]]:
+        """
+        The `slice()` function returns `at(i)` for every `i` in `range(start, stop, step)`.
+
+        Examples:
+            >>> hgen = Halton([2, 3], [11, 7])
+            >>> hgen.slice(0, 2)
+            [[1024, 729], [512, 1458]]
+        """
+        xs = self._vdc0.slice(start, stop, step)
+        ys = self._vdc1.slice(start, stop, step)
+        return [list(pt) for pt in zip(xs, ys)]
+
+    def fill(self, out, order: str = "C", start: Optional[int] = None) -> None:
+        """
+        The `fill()` function writes consecutive points of the sequence into a caller-supplied buffer.
+
+        :param out: The parameter `out` is a writable, C-contiguous buffer of integers holding `(n, 2)`
+        values. The number of points `n` is derived from its size.
+
+        :param order: The `order` parameter selects the layout of `out`, either "C" (row-major) or "F"
+        (column-major), defaults to "C"
+
+        :type order: str (optional)
+
+        :param start: The `start` parameter selects random access: when given, `out` receives
+        `slice(start, start + n)` and the state of the generator is left unchanged.
+
+        :type start: int (optional)
+
+        Examples:
+            >>> hgen = Halton([2, 3], [11, 7])
+            >>> out = array("I", bytes(4 * 4))
+            >>> hgen.fill(out)
+            >>> out.tolist()
+            [1024, 729, 512, 1458]
+        """
+        view = _flat_view(out, _INT_TYPECODES)
+        n = _rows(view, 2)
+        for j, vdc in enumerate([self._vdc0, self._vdc1]):
+            col = array(view.format, bytes(view.itemsize * n))
+            vdc.fill(col, start)
+            _write_column(view, col, j, 2, order)
+
+
+if _native is not None:
+    # the compiled kernel returns exactly the same values
+    vdc_i = _native.vdc_i  # noqa: F811
+    _vdc_i = _native.vdc_i  # noqa: F811
+
 
 if __name__ == "__main__":
     import doctest
@@ -0,0 +1,203 @@
+"""
+Kronecker (rank-1 lattice rule) sequence generator
+
+The points are `x_k = frac(shift + k * alpha)` for a vector `alpha` of irrational numbers, so
+every step costs one addition per dimension, independent of the number of points. The default
+`alpha` is the R_d sequence of Roberts: `alpha_j = 1 / phi_d**j` for `j = 1 .. d`, where
+`phi_d` is the positive root of `x**(d + 1) == x + 1` (the golden ratio for `d == 1`).
+
+The coordinates are kept in 64-bit fixed point: `alpha` and `shift` are rounded once to
+multiples of 2**-64 and every point is computed exactly modulo 1, so the sequence does not drift
+however many steps are taken, and `pop()`, `slice()` and `reseed()` agree bit for bit at every
+index. Each value is the top 53 bits of its fixed-point coordinate, in [0, 1).
+"""
+
+from array import array
+from decimal import Decimal, localcontext
+from fractions import Fraction
+from typing import List, Optional, Sequence
+
+from .lds import _PointBatch
+
+try:
+    from . import _native
+except ImportError:  # pragma: no cover
+    _native = None
+
+# Number of fixed-point bits of alpha and of the coordinates
+BITS = 64
+
+_MASK = (1 << BITS) - 1
+_DROP = BITS - 53
+_SCALE = 2.0**-53
+
+
+def harmonious(d: int) -> Decimal:
+    """
+    The `harmonious()` function returns `phi_d`, the positive root of `x**(d + 1) == x + 1`, to
+    60 significant digits.
+
+    Examples:
+        >>> str(harmonious(1))[:12]
+        '1.6180339887'
+    """
+    with localcontext() as ctx:
+        ctx.prec = 60
+        x = Decimal(2)
+        while True:
+            step = (x ** (d + 1) - x - 1) / ((d + 1) * x**d - 1)
+            x -= step
+            if abs(step) < Decimal(10) ** -55:
+                return +x
+
+
+def rd_alpha(d: int) -> List[int]:
+    """
+    The `rd_alpha()` function returns the R_d vector `alpha` of `d` dimensions as `BITS`-bit
+    fixed-point integers, i.e. `round(alpha_j * 2**BITS)`.
+
+    Examples:
+        >>> rd_alpha(1)[0] / 2**64
+        0.6180339887498949
+    """
+    phi = harmonious(d)
+    with localcontext() as ctx:
+        ctx.prec = 60
+        scale = Decimal(1 << BITS)
+        return [int((phi**-j * scale).to_integral_value()) for j in range(1, d + 1)]
+
+
+def _fixed(value) -> int:
+    """The fractional part of a real number (float, Fraction, Decimal) in fixed point"""
+    return round(Fraction(value) * (1 << BITS)) & _MASK
+
+
+def _column(x0: int, delta: int, n: int) -> array:
+    """The values of the fixed-point coordinates `x0 + i * delta` for `i < n`"""
+    col = array("d", bytes(8 * n))
+    if _native is not None:
+        _native.kronecker_fill(col, x0, delta)
+        return col
+    for i in range(n):
+        col[i] = (((x0 + i * delta) & _MASK) >> _DROP) * _SCALE
+    return col
+
+
+class Kronecker(_PointBatch):
+    """Kronecker sequence generator
+
+    Examples:
+        >>> kgen = Kronecker(2)
+        >>> kgen.reseed(0)
+        >>> kgen.pop()
+        [0.7548776662466927, 0.5698402909980532]
+        >>> kgen.pop_batch(2).tolist() == kgen.slice(1, 3).tolist()
+        True
+    """
+
+    count: int
+
+    def __init__(
+        self,
+        n: int,
+        alpha: Optional[Sequence] = None,
+        shift: Optional[Sequence] = None,
+    ) -> None:
+        """
+        The function initializes the generator of `n` dimensions.
+
+        :param n: The parameter `n` is the number of dimensions
+
+        :type n: int
+
+        :param alpha: The `alpha` parameter holds the `n` increments, real numbers of which only
+        the fractional part counts (floats, `Fraction`s or `Decimal`s), defaults to the R_d
+        vector `rd_alpha(n)`
+
+        :type alpha: Sequence (optional)
+
+        :param shift: The `shift` parameter holds the `n` coordinates of the point with index 0,
+        defaults to the origin
+
+        :type shift: Sequence (optional)
+        """
+        if n < 1:
+            raise ValueError("n must be positive")
+        if alpha is None:
+            self._alpha = rd_alpha(n)
+        else:
+            self._alpha = [_fixed(a) for a in alpha]
+        self._shift = [0] * n if shift is None else [_fixed(s) for s in shift]
+        if len(self._alpha) != n or len(self._shift) != n:
+            raise ValueError(f"alpha and shift must have {n} entries")
+        self.reseed(0)
+
+    @property
+    def dim(self) -> int:
+        return len(self._alpha)
+
+    @property
+    def alpha(self) -> List[float]:
+        """The increments, rounded to float"""
+        return [a / (1 << BITS) for a in self._alpha]
+
+    def _fixed_point(self, k: int) -> List[int]:
+        """The fixed-point coordinates of the point with index `k`"""
+        return [(s + k * a) & _MASK for s, a in zip(self._shift, self._alpha)]
+
+    def pop(self) -> List[float]:
+        """
+        The `pop()` function returns the next point, adding `alpha` to every coordinate.
+
+        Examples:
+            >>> Kronecker(1).pop()
+            [0.6180339887498948]
+        """
+        self.count += 1
+        self._x = [(x + a) & _MASK for x, a in zip(self._x, self._alpha)]
+        return [(x >> _DROP) * _SCALE for x in self._x]
+
+    def _columns(self, n: int, ks: Optional[range]) -> List[array]:
+        if ks is None:
+            ks = range(self.count, self.count + n)
+            self.count += n
+            self._x = self._fixed_point(self.count)
+        args = range(ks.start + 1, ks.stop + 1, ks.step)
+        return [
+            _column((s + args.start * a) & _MASK, (args.step * a) & _MASK, n)
+            for s, a in zip(self._shift, self._alpha)
+        ]
+
+    def at(self, index: int) -> List[float]:
+        """
+        The `at()` function returns the point that `pop()` returns right after `reseed(index)`.
+
+        Examples:
+            >>> Kronecker(2).at(10**10) == Kronecker(2).slice(10**10, 10**10 + 1).tolist()
+            True
+        """
+        return [(x >> _DROP) * _SCALE for x in self._fixed_point(index + 1)]
+
+    def reseed(self, seed: int) -> None:
+        """
+        The `reseed` function resets the state of a sequence generator to a specific seed value.
+
+        This is an O(dim) skip-ahead: after `reseed(i)` the next `pop()` returns `at(i)`.
+
+        :param seed: The `seed` parameter is an integer value that is used to reset the state of the
+        sequence generator. It determines the starting point of the sequence generation
+
+        :type seed: int
+        """
+        self.count = seed
+        self._x = self._fixed_point(seed)
+
+
+# The R_d sequence is the Kronecker sequence with the default alpha
+Rd = Kronecker
+
+
+if __name__ == "__main__":
+    import doctest
+
+    doctest.testmod()
@@ -1,12 +1,72 @@
 """
 This module contains low-discrepancy sequence generators
+
+The batch functions (`pop_batch()`, `fill()`, `slice()` and `chunks()`) produce float64 values
+by default. With `dtype="f"` (or "float32") they produce float32 values, half the size; every
+value is computed in float64 and rounded once when it is stored. The precision limits the
+number of distinct values per coordinate: the `vdc()` values of the first `N` indices differ by
+at least `1 / (base * N)`, so they stay distinct in float32 for `N < 2**24 / base` (for base 2
+up to `N = 2**24`, where they are exact) and in float64 for `N < 2**53 / base`. Beyond that
+neighbouring values in [0.5, 1) start to coincide. The coordinates of `Circle`, `Sphere` and
+`Sphere3Hopf` carry an absolute rounding error of at most 2**-25 (about 3e-8) in float32,
+against a few units of 2**-53 in float64.
+
+`set_engine("fixed")` switches all float generators to the radical inverses of `vdc_fixed()`,
+computed in unsigned 64-bit integer arithmetic with a single conversion to float64 per value.
 """
 
-from math import cos, pi, sin, sqrt
-from typing import List, Sequence
+import sys
+import warnings
+from array import array
+from fractions import Fraction
+from math import cos, gcd, log, pi, sin, sqrt
+from itertools import compress, repeat
+from operator import add, mul, sub
+from typing import (
+    Callable,
+    Dict,
+    Iterable,
+    Iterator,
+    List,
+    Optional,
+    Sequence,
+    Tuple,
+    TypeVar,
+)
+
+from .block import PointBlock
+from .tables import float_table
+
+try:
+    from . import _native
+except ImportError:  # pragma: no cover
+    _native = None
 
 TWO_PI = 2.0 * pi
 
+_T = TypeVar("_T")
+
+# Below this count `vdc` in base 2 is an exact bit reversal
+_BIT_REVERSE_LIMIT = 2**53
+
+_NATIVE_ORDER = "<" if sys.byteorder == "little" else ">"
+
+# `array` typecodes of the floating-point batch output, by `dtype` name
+DTYPES = {"d": "d", "float64": "d", "f": "f", "float32": "f"}
+
+# Trigonometric modes of the batch output of Circle, Sphere and Sphere3Hopf
+TRIG_MODES = ("exact", "table")
+
+# Upper bound of the number of entries of an angle-addition table
+_TRIG_SPAN = 4096
+
+_trig_tables: Dict[int, Tuple[array, array]] = {}
+
+# Engines of the radical inverses, see `set_engine()`
+ENGINES = ("float", "fixed")
+
+_engine = "float"
+
 
 def vdc(k: int, base: int = 2) -> float:
     """Van der Corput sequence
@@ -25,12 +85,29 @@ def vdc(k: int, base: int = 2) -> float:
 
     :return: The function `vdc` returns a floating point value.
 
+    For base 2 the result is computed as a bit reversal of `k`. For other small bases the lowest
+    digits are looked up in a cached table (see `lds_gen.tables`) and the summation continues with
+    the remaining digits; either way the result is bit-for-bit that of the digit-by-digit loop.
+    With the fixed-point engine (see `set_engine()`) the result is `vdc_fixed(k, base)`.
+
     Examples:
         >>> vdc(11, 2)
         0.8125
     """
+    if _engine == "fixed":
+        return vdc_fixed(k, base)
+    if base == 2 and k < _BIT_REVERSE_LIMIT:
+        bits = bin(k)[:1:-1]  # binary digits, least significant first
+        return int(bits, 2) / (1 << len(bits))
     res = 0.0
     denom = 1.0
+    table = float_table(base)
+    if table is not None:
+        if k < len(table):
+            return table[k]
+        k, low = divmod(k, len(table))
+        res = table[low]
+        denom = float(len(table))
     while k != 0:
         denom *= base
         remainder = k % base
@@ -39,6 +116,300 @@ def vdc(k: int, base: int = 2) -> float:
     return res
 
 
+def vdc_fixed(k: int, base: int = 2) -> float:
+    """Van der Corput sequence (fixed-point version)
+
+    The digits of `k` are reversed into the integer numerator of `vdc(k) * base**digits` with
+    unsigned 64-bit arithmetic, as in `ilds.vdc_i()`, and the numerator is converted to float64
+    with a single multiplication by `1 / base**digits`. A digit that does not fit into 64 bits
+    any more is added as `digit / base` before the conversion (and so are the further digits of
+    an index beyond 64 bits, recursively). For base 2 and `k < 2**53` the result is exact, as is
+    `vdc()`; for other bases it is within three units in the last place of the exact value. The
+    compiled kernels compute the same operations and give the same bits.
+
+    :param k: The parameter `k` is a non-negative integer
+
+    :type k: int
+
+    :param base: The `base` parameter is the base of the sequence, defaults to 2
+
+    :type base: int (optional)
+
+    Examples:
+        >>> vdc_fixed(11, 2)
+        0.8125
+        >>> abs(vdc_fixed(7, 3) - vdc(7, 3)) < 1e-16
+        True
+    """
+    num, den = 0, 1
+    while k != 0 and den * base < 2**64:
+        k, remainder = divmod(k, base)
+        num = num * base + remainder
+        den *= base
+    high = k / base if k < base else vdc_fixed(k, base)
+    return (num + high) * (1.0 / float(den))
+
+
+def _vdc_fixed_range(start: int, n: int, base: int) -> array:
+    """`vdc_fixed()` of `n` consecutive integers starting at `start`
+
+    The integers with the same number of digits are evaluated digit position by digit position,
+    as in `_vdc_range()`.
+    """
+    res = array("d")
+    k, stop = start, start + n
+    while k < stop:
+        den = base
+        while den <= k:
+            den *= base
+        if den >= 2**64:
+            res.extend([vdc_fixed(i, base) for i in range(k, stop)])
+            break
+        m = min(den, stop) - k
+        nums = [0] * m
+        span = weight = 1
+        while span < den:
+            span *= base
+        while weight < den:
+            span //= base
+            terms = _digit_terms(k, m, span, [d * weight for d in range(base)])
+            nums = list(map(add, nums, terms))
+            weight *= base
+        inv = 1.0 / float(den)
+        res.extend([x * inv for x in nums])
+        k += m
+    return res
+
+
+def set_engine(engine: str) -> None:
+    """
+    The `set_engine()` function selects how all float generators of the process compute the
+    radical inverses: "float" (the default) accumulates the digits of every index in float64 as
+    `vdc()` describes, "fixed" uses the integer arithmetic of `vdc_fixed()`.
+
+    Set the engine before creating or reseeding generators: an `IncrementalVdCorput` keeps the
+    value of its current index. The GPU kernels of `lds_gen.gpu` always use the float engine.
+
+    :param engine: The `engine` parameter is one of `ENGINES`
+
+    :type engine: str
+
+    Examples:
+        >>> set_engine("fixed")
+        >>> VdCorput(2).slice(0, 3).tolist()
+        [0.5, 0.25, 0.75]
+        >>> set_engine("float")
+    """
+    global _engine
+    if engine not in ENGINES:
+        raise ValueError(f"engine must be one of {ENGINES}, got {engine!r}")
+    if _native is not None:
+        _native.set_engine(engine == "fixed")
+    _engine = engine
+    _trig_tables.clear()
+
+
+def get_engine() -> str:
+    """
+    The `get_engine()` function returns the engine of the radical inverses, see `set_engine()`.
+    """
+    return _engine
+
+
+def _digit_terms(start: int, n: int, span: int, vals: Sequence[_T]) -> List[_T]:
+    """Digit contributions of one position over a run of consecutive integers
+
+    For every `k` in `range(start, start + n)` the digit of `k` at the
+    position of weight `span` (i.e. `(k // span) % base`) is constant over runs
+    of `span` consecutive integers and cycles with period `base * span`. The
+    term list is therefore assembled from repeated slices rather than from a
+    per-element division.
+
+    :param start: the first integer of the run
+    :param n: the number of consecutive integers
+    :param span: the weight `base**i` of the digit position
+    :param vals: the term of each digit value, so `base == len(vals)`
+    :return: the list of `vals[digit]` for each integer of the run
+    """
+    base = len(vals)
+    period = base * span
+    if period <= 2 * n:
+        cycle: List[_T] = []
+        for v in vals:
+            cycle += [v] * span
+        terms = cycle[start % period :]
+        terms += cycle * ((n - len(terms)) // period + 1)
+        del terms[n:]
+        return terms
+    terms = []
+    k, stop = start, start + n
+    while k < stop:
+        run = min(span - k % span, stop - k)
+        terms += [vals[(k // span) % base]] * run
+        k += run
+    return terms
+
+
+def _into(out, values: array):
+    """`values`, copied into the float64 or float32 buffer `out` unless it is None"""
+    if out is None:
+        return values
+    _store(memoryview(out), values, 0, 1)
+    return out
+
+
+def _store(view: memoryview, values: array, offset: int, step: int) -> None:
+    """Store the float64 `values` into `view[offset::step]`
+
+    A float32 `view` receives the rounded values; the compiled kernel converts
+    them in place, without an intermediate `array("f")`.
+    """
+    if view.format != values.typecode:
+        if _native is not None:
+            _native.store_fill(view, values, offset, step)
+            return
+        values = array(view.format, values)
+    view[offset : offset + step * (len(values) - 1) + 1 : step] = values
+
+
+def _vdc_range(start: int, n: int, base: int, out=None) -> array:
+    """Van der Corput values of `n` consecutive integers starting at `start`
+
+    The sequence is evaluated digit position by digit position over the whole
+    run, adding the terms in the same order as `vdc` does, so that every entry
+    is bit-for-bit identical to the scalar result. The compiled kernel writes
+    into `out` directly when it is given.
+    """
+    if _native is not None:
+        res = array("d", bytes(8 * n)) if out is None else out
+        try:
+            _native.vdc_fill(res, start, 1, base)
+            return res
+        except OverflowError:
+            pass
+    if _engine == "fixed":
+        return _into(out, _vdc_fixed_range(start, n, base))
+    last = start + n - 1
+    res = [0.0] * n
+    span = 1
+    denom = 1.0
+    while span <= last:
+        denom *= base
+        vals = [d / denom for d in range(base)]
+        res = list(map(add, res, _digit_terms(start, n, span, vals)))
+        span *= base
+    return _into(out, array("d", res))
+
+
+def vdc_batch(ks: Iterable[int], base: int = 2, out=None) -> array:
+    """Van der Corput sequence (batch version)
+
+    The function `vdc_batch` evaluates `vdc(k, base)` for every `k` in `ks` and
+    stores the results in a contiguous `array("d")` of float64 values, which
+    can be wrapped without copying by any consumer of the buffer protocol
+    (e.g. `numpy.frombuffer`). When `ks` is a `range` of consecutive integers
+    the values are computed one digit position at a time over the whole range,
+    avoiding the per-point interpreter overhead of the scalar digit loop.
+
+    :param ks: The parameter `ks` is an iterable of non-negative integers
+
+    :type ks: Iterable[int]
+
+    :param base: The `base` parameter represents the base of the number system being used, defaults to 2
+
+    :type base: int (optional)
+
+    :param out: The `out` parameter is a writable float64 or float32 buffer of `len(ks)`
+    values that receives the results, which the compiled kernels write in place, defaults
+    to None
+
+    :return: The function `vdc_batch` returns an `array("d")` with one value per element of `ks`,
+    or `out` if given.
+
+    Examples:
+        >>> vdc_batch(range(1, 5), 2).tolist()
+        [0.5, 0.25, 0.75, 0.125]
+        >>> vdc_batch([11, 1], 2).tolist()
+        [0.8125, 0.5]
+    """
+    if isinstance(ks, range):
+        if ks.step == 1:
+            return _vdc_range(ks.start, len(ks), base, out)
+        if _native is not None:
+            res = array("d", bytes(8 * len(ks))) if out is None else out
+            try:
+                _native.vdc_fill(res, ks.start, ks.step, base)
+                return res
+            except OverflowError:
+                pass
+    return _into(out, array("d", [vdc(k, base) for k in ks]))
+
+
+def _typecode(dtype: str) -> str:
+    """The `array` typecode of a floating-point `dtype` name"""
+    code = DTYPES.get(dtype) if isinstance(dtype, str) else None
+    if code is None:
+        raise ValueError(f"dtype must be one of {list(DTYPES)}, got {dtype!r}")
+    return code
+
+
+def _zeros(dtype: str, shape: Tuple[int, ...], order: str = "C") -> PointBlock:
+    """A block of zeros of `dtype` with `shape`"""
+    return PointBlock(_typecode(dtype), shape, order)
+
+
+def _values(
+    n: int, dtype: str, batch: Callable[[PointBlock], array]
+) -> PointBlock:
+    """The `n` values `batch(out)` as a flat block of `dtype`
+
+    The block is allocated first and passed as `out`, so that the compiled
+    kernels fill it in place, rounding to float32 as they store the values.
+    """
+    return batch(PointBlock(_typecode(dtype), (n,)))
+
+
+def _flat_view(out, typecodes: str = "d") -> memoryview:
+    """Flat writable view of a caller-supplied C-contiguous buffer
+
+    The item format of `out` (in native byte order) must be one of the
+    `array` typecodes in `typecodes`.
+    """
+    view = memoryview(out)
+    if view.readonly:
+        raise ValueError("output buffer is read-only")
+    code = view.format.lstrip("@=" + _NATIVE_ORDER)
+    if len(code) != 1 or code not in typecodes:
+        raise TypeError(
+            f"output buffer must hold {typecodes!r} items, got {view.format!r}"
+        )
+    if view.ndim != 1 or view.format != code:
+        view = view.cast("B").cast(code)
+    return view
+
+
+def _write_column(view: memoryview, col: array, j: int, dim: int, order: str) -> None:
+    """Store coordinate `j` of `len(col)` points into a flat `(n, dim)` buffer
+
+    With `order="C"` (row-major) the points are stored one after another; with
+    `order="F"` (column-major) each coordinate is stored contiguously.
+    """
+    if order == "C":
+        _store(view, col, j, dim)
+    elif order == "F":
+        _store(view, col, j * len(col), 1)
+    else:
+        raise ValueError(f"order must be 'C' or 'F', got {order!r}")
+
+
+def _rows(view: memoryview, dim: int) -> int:
+    """Number of `dim`-dimensional points held by a flat buffer"""
+    n, rem = divmod(len(view), dim)
+    if rem != 0:
+        raise ValueError(f"output buffer size {len(view)} is not a multiple of {dim}")
+    return n
+
+
 class VdCorput:
     """Van der Corput sequence generator
 
@@ -65,12 +436,27 @@ class VdCorput:
         0.0625
         0.5625
         0.3125
+
+    With `leap=P` and `offset=j` the generator yields the substream of the indices `j`, `j + P`,
+    `j + 2 * P`, ... of the sequence, so that `P` workers with the offsets `0 .. P - 1` share the
+    sequence out point by point. Only the values of the substream are computed. A leap sharing a
+    factor with the base is bad: for a multiple of the base all values of a substream fall into
+    one interval of length `1 / base` (and into one of length `1 / base**m` for a multiple of
+    `base**m`); such leaps raise a `RuntimeWarning`. Leaps that are primes other than the bases
+    in use keep the substreams well distributed.
+
+        >>> [VdCorput(2, leap=3, offset=j).pop_batch(2).tolist() for j in range(3)]
+        [[0.5, 0.125], [0.25, 0.625], [0.75, 0.375]]
     """
 
     count: int
     base: int
+    leap: int
+    offset: int
+    dim = 1
+    dtype = "d"
 
-    def __init__(self, base: int = 2) -> None:
+    def __init__(self, base: int = 2, leap: int = 1, offset: int = 0) -> None:
         """
         The function initializes an object with a base and scale value, and sets the count to 0.
 
@@ -79,9 +465,30 @@ class VdCorput:
         However, you can change the value of `base` to any other prime number to use a different, defaults to 2
 
         :type base: int (optional)
+
+        :param leap: The `leap` parameter is the distance between the indices of the substream,
+        defaults to 1 (the whole sequence)
+
+        :type leap: int (optional)
+
+        :param offset: The `offset` parameter is the index of the first value of the substream,
+        defaults to 0
+
+        :type offset: int (optional)
         """
+        if leap < 1 or offset < 0:
+            raise ValueError("leap must be positive and offset non-negative")
+        if gcd(leap, base) > 1:
+            warnings.warn(
+                f"leap {leap} shares a factor with base {base}: "
+                "the values of the substream are badly distributed",
+                RuntimeWarning,
+                stacklevel=2,
+            )
         self.count = 0
         self.base = base
+        self.leap = leap
+        self.offset = offset
 
     def pop(self) -> float:
         """
@@ -102,7 +509,332 @@ class VdCorput:
             0.5
         """
         self.count += 1
-        return vdc(self.count, self.base)
+        return vdc(self.offset + (self.count - 1) * self.leap + 1, self.base)
+
+    def _arguments(self, ks: range) -> range:
+        """The `vdc()` arguments of the values at the indices `ks` of the substream"""
+        leap, first = self.leap, self.offset + 1
+        return range(first + ks.start * leap, first + ks.stop * leap, ks.step * leap)
+
+    def __iter__(self) -> "VdCorput":
+        return self
+
+    def __next__(self) -> float:
+        """
+        The `__next__()` function returns `pop()`, so that the generator can be used as an
+        (endless) iterator.
+
+        Examples:
+            >>> from itertools import islice
+            >>> list(islice(VdCorput(2), 3))
+            [0.5, 0.25, 0.75]
+        """
+        return self.pop()
+
+    def chunks(self, chunk_size: int, dtype: str = "d") -> Iterator[PointBlock]:
+        """
+        The `chunks()` function yields the sequence in consecutive blocks of `chunk_size` values.
+
+        One array is allocated up front and refilled for every block, so memory use stays
+        constant no matter how many blocks are consumed. The same buffer object is yielded each
+        time; copy it if a block has to outlive the next iteration. The generator is endless.
+
+        :param chunk_size: The `chunk_size` parameter is the number of values per block
+
+        :type chunk_size: int
+
+        :param dtype: The `dtype` parameter is "d" (float64) or "f" (float32), see the module
+        documentation, defaults to "d"
+
+        :type dtype: str (optional)
+
+        Examples:
+            >>> blocks = VdCorput(2).chunks(2)
+            >>> next(blocks).tolist()
+            [0.5, 0.25]
+            >>> next(blocks).tolist()
+            [0.75, 0.125]
+        """
+        buf = _zeros(dtype, (chunk_size,))
+        while True:
+            self.fill(buf)
+            yield buf
+
+    def pop_batch(self, n: int, dtype: str = "d") -> PointBlock:
+        """
+        The `pop_batch()` function generates the next `n` values in the sequence at once.
+
+        The values are exactly those returned by `n` successive calls to `pop()`, and `count` is
+        advanced by `n` in the same way.
+
+        :param n: The parameter `n` is the number of values to generate
+
+        :type n: int
+
+        :param dtype: The `dtype` parameter is "d" (float64) or "f" (float32), see the module
+        documentation, defaults to "d"
+
+        :type dtype: str (optional)
+
+        :return: The function `pop_batch` returns a `block.PointBlock` of `n` float64 (or
+        float32) values, an `array` that exports its memory without copying.
+
+        Examples:
+            >>> vgen = VdCorput(2)
+            >>> vgen.pop_batch(4).tolist()
+            [0.5, 0.25, 0.75, 0.125]
+            >>> vgen.pop()
+            0.625
+            >>> vgen.pop_batch(2, dtype="f")
+            PointBlock('f', [0.375, 0.875])
+        """
+        args = self._arguments(range(self.count, self.count + n))
+        self.count += n
+        return _values(n, dtype, lambda out: vdc_batch(args, self.base, out))
+
+    def fill(self, out, start: Optional[int] = None) -> None:
+        """
+        The `fill()` function writes `len(out)` consecutive values of the sequence into `out`.
+
+        :param out: The parameter `out` is a writable, C-contiguous buffer of float64 or float32
+        values (for example an `array("d")` or a `numpy.ndarray`).
+
+        :param start: The `start` parameter selects random access: when given, `out` receives
+        `slice(start, start + len(out))` and the state of the generator is left unchanged. By
+        default the next values are written and `count` is advanced, as with `pop_batch()`.
+
+        :type start: int (optional)
+
+        Examples:
+            >>> out = array("d", bytes(8 * 3))
+            >>> VdCorput(2).fill(out)
+            >>> out.tolist()
+            [0.5, 0.25, 0.75]
+        """
+        view = _flat_view(out, "df")
+        if start is None:
+            view[:] = self.pop_batch(len(view), view.format)
+        else:
+            view[:] = self.slice(start, start + len(view), dtype=view.format)
+
+    def at(self, index: int) -> float:
+        """
+        The `at()` function returns the value that `pop()` returns right after `reseed(index)`.
+
+        The state of the generator is not changed.
+
+        :param index: The `index` parameter is the position in the sequence
+
+        :type index: int
+
+        Examples:
+            >>> vgen = VdCorput(2)
+            >>> vgen.at(10)
+            0.8125
+        """
+        return vdc(self.offset + index * self.leap + 1, self.base)
+
+    def slice(
+        self, start: int, stop: int, step: int = 1, dtype: str = "d"
+    ) -> PointBlock:
+        """
+        The `slice()` function returns `at(i)` for every `i` in `range(start, stop, step)`.
+
+        This is exactly what `reseed(start)` followed by `stop - start` calls to `pop()` would return
+        (for `step == 1`), computed directly without generating the preceding values. The state of
+        the generator is not changed. The `dtype` parameter is as for `pop_batch()`.
+
+        Examples:
+            >>> vgen = VdCorput(2)
+            >>> vgen.slice(2, 5).tolist()
+            [0.75, 0.125, 0.625]
+        """
+        args = self._arguments(range(start, stop, step))
+        return _values(len(args), dtype, lambda out: vdc_batch(args, self.base, out))
+
+    def reseed(self, seed: int) -> None:
+        """
+        The `reseed` function resets the state of a sequence generator to a specific seed value.
+
+        Since every value depends on its index only, this is an O(1) skip-ahead: after
+        `reseed(i)` the next `pop()` returns `at(i)`.
+
+        :param seed: The `seed` parameter is an integer value that is used to reset the state of the
+        sequence generator. It determines the starting point of the sequence generation
+
+        :type seed: int
+        """
+        self.count = seed
+
+
+class IncrementalVdCorput(VdCorput):
+    """Van der Corput sequence generator with incremental digit update
+
+    `IncrementalVdCorput` produces exactly the same values as `VdCorput`, but
+    keeps the base-`base` digits of `count` between calls. Stepping `count` to
+    `count + 1` only touches the digits affected by the carry, which is
+    amortized O(1).
+
+    Only for power-of-two bases is the whole `pop()` O(1): every partial sum is
+    exactly representable (up to 2**53), so the value itself is updated from the
+    carry with a single addition. For other bases the value is re-accumulated
+    from cached per-digit terms in the same order as `vdc`, which keeps the
+    result bit-for-bit identical but still costs O(log_b k) additions. The same
+    holds with a `leap` (see `VdCorput`), whose digits are added to those of the
+    next `vdc()` argument with carries, and the fixed-point engine evaluates
+    `vdc_fixed()` for every value. None of that beats the compiled `vdc`, so
+    when it is available `pop()` calls it directly in these cases.
+
+    Use `VdCorput` unless the base is a power of two.
+
+    Examples:
+        >>> vgen = IncrementalVdCorput(3)
+        >>> vgen.reseed(0)
+        >>> [vgen.pop() for _ in range(4)] == [vdc(k, 3) for k in range(1, 5)]
+        True
+    """
+
+    _digits: List[int]
+    _terms: List[List[float]]
+    _deltas: List[float]
+    _value: float
+
+    def __init__(self, base: int = 2, leap: int = 1, offset: int = 0) -> None:
+        """
+        The function initializes the generator with a base and sets the count to 0.
+
+        :param base: The `base` parameter is an optional integer argument that specifies the base of the
+        number system, defaults to 2
+
+        :type base: int (optional)
+
+        :param leap: The `leap` parameter is the distance between the indices of the substream,
+        see `VdCorput`, defaults to 1
+
+        :type leap: int (optional)
+
+        :param offset: The `offset` parameter is the index of the first value of the substream,
+        defaults to 0
+
+        :type offset: int (optional)
+
+        Examples:
+            >>> vgen = IncrementalVdCorput(3, leap=5, offset=2)
+            >>> [vgen.pop() for _ in range(3)] == VdCorput(3, 5, 2).pop_batch(3).tolist()
+            True
+        """
+        super().__init__(base, leap, offset)
+        self._leap_digits = _digits_of(leap, base)
+        # In a power-of-two base every partial sum of `vdc` is exact as long as
+        # all digits fit into the 53-bit mantissa of a float.
+        self._exact_digits = 0
+        if base & (base - 1) == 0:
+            while base ** (self._exact_digits + 1) <= 2**53:
+                self._exact_digits += 1
+        self._terms = []
+        self._deltas = []
+        self.reseed(0)
+
+    def _grow(self, ndigits: int) -> None:
+        """Extend the cached per-digit tables to `ndigits` positions"""
+        base = self.base
+        denom = 1.0
+        for _ in self._terms:
+            denom *= base
+        while len(self._terms) < ndigits:
+            i = len(self._terms)
+            denom *= base
+            self._terms.append([d / denom for d in range(base)])
+            if i < self._exact_digits:
+                # value change when digits 0..i-1 wrap to 0 and digit i is incremented
+                self._deltas.append(
+                    float(Fraction(1, base ** (i + 1)) + Fraction(1, base**i) - 1)
+                )
+
+    def pop(self) -> float:
+        """
+        The `pop()` function increments the count and returns the next value in the sequence.
+
+        Examples:
+            >>> vgen = IncrementalVdCorput(2)
+            >>> vgen.pop()
+            0.5
+        """
+        if _native is not None and (
+            _engine == "fixed"
+            or self.leap != 1
+            or len(self._digits) >= self._exact_digits
+        ):
+            # no single addition: the compiled `vdc` is faster than the digits
+            self.count += 1
+            return vdc(self.offset + (self.count - 1) * self.leap + 1, self.base)
+        if self.leap != 1:
+            return self._leap_pop()
+        digits = self._digits
+        last = self.base - 1
+        i = 0
+        while i < len(digits) and digits[i] == last:
+            digits[i] = 0
+            i += 1
+        if i == len(digits):
+            digits.append(1)
+            self._grow(i + 1)
+        else:
+            digits[i] += 1
+        self.count += 1
+        if _engine == "fixed":
+            return vdc_fixed(self.offset + self.count, self.base)
+        if len(digits) <= self._exact_digits:
+            self._value += self._deltas[i]
+            return self._value
+        res = 0.0
+        for terms, d in zip(self._terms, digits):
+            res += terms[d]
+        return res
+
+    def _leap_pop(self) -> float:
+        """`pop()` with a leap: the digits are those of the next `vdc()` argument"""
+        digits = self._digits
+        if _engine == "fixed":
+            res = vdc_fixed(self.offset + self.count * self.leap + 1, self.base)
+        else:
+            res = 0.0
+            for terms, d in zip(self._terms, digits):
+                res += terms[d]
+        base = self.base
+        carry = 0
+        i = 0
+        for d in self._leap_digits:
+            if i == len(digits):
+                digits.append(0)
+            total = digits[i] + d + carry
+            carry = total >= base
+            digits[i] = total - base if carry else total
+            i += 1
+        while carry:
+            if i == len(digits):
+                digits.append(0)
+            carry = digits[i] == base - 1
+            digits[i] = 0 if carry else digits[i] + 1
+            i += 1
+        self._grow(len(digits))
+        self.count += 1
+        return res
+
+    def pop_batch(self, n: int, dtype: str = "d") -> PointBlock:
+        """
+        The `pop_batch()` function generates the next `n` values in the sequence at once.
+
+        Examples:
+            >>> vgen = IncrementalVdCorput(2)
+            >>> vgen.pop_batch(3).tolist()
+            [0.5, 0.25, 0.75]
+            >>> vgen.pop()
+            0.125
+        """
+        res = super().pop_batch(n, dtype)
+        self.reseed(self.count)
+        return res
 
     def reseed(self, seed: int) -> None:
         """
@@ -114,9 +846,291 @@ class VdCorput:
         :type seed: int
         """
         self.count = seed
+        arg = self.offset + seed * self.leap
+        if self.leap != 1:
+            # the digits of the next `vdc()` argument, see `_leap_pop()`
+            arg += 1
+        self._digits = _digits_of(arg, self.base)
+        self._grow(len(self._digits))
+        self._value = vdc(arg, self.base)
+
+
+def _digits_of(k: int, base: int) -> List[int]:
+    """The base-`base` digits of `k`, least significant first"""
+    digits = []
+    while k != 0:
+        k, d = divmod(k, base)
+        digits.append(d)
+    return digits
+
+
+def _arguments(vdc: VdCorput, n: int, ks: Optional[range]) -> range:
+    """The `vdc()` arguments of the next `n` values of `vdc` (advancing it), or
+    of its values at the indices in `ks`"""
+    if ks is None:
+        ks = range(vdc.count, vdc.count + n)
+        vdc.count += n
+    return vdc._arguments(ks)
+
+
+def _coords(vdc: VdCorput, n: int, ks: Optional[range]) -> array:
+    """The next `n` values of `vdc`, or its values at the indices in `ks`"""
+    return vdc_batch(_arguments(vdc, n, ks), vdc.base)
+
+
+def _native_columns(
+    kernel: str, dim: int, args: range, *bases: int, tables: Sequence[array] = ()
+) -> Optional[List[array]]:
+    """Coordinate columns computed by a compiled kernel for the `vdc()`
+    arguments `args`, or None if the kernel is not available for them"""
+    if _native is None:
+        return None
+    cols = [array("d", bytes(8 * len(args))) for _ in range(dim)]
+    try:
+        getattr(_native, kernel)(*cols, *tables, args.start, args.step, *bases)
+    except OverflowError:
+        return None
+    return cols
+
+
+def _check_trig(trig: str) -> str:
+    if trig not in TRIG_MODES:
+        raise ValueError(f"trig must be one of {TRIG_MODES}, got {trig!r}")
+    return trig
+
+
+def _trig_table(base: int) -> Tuple[array, array]:
+    """sin and cos of `2 * pi * vdc(lo, base)` for all `lo < base**m`, where `m`
+    is the largest exponent with `base**m <= _TRIG_SPAN` (at least 1)"""
+    table = _trig_tables.get(base)
+    if table is None:
+        span = base
+        while span * base <= _TRIG_SPAN:
+            span *= base
+        thetas = [v * TWO_PI for v in vdc_batch(range(span), base)]
+        table = (array("d", map(sin, thetas)), array("d", map(cos, thetas)))
+        _trig_tables[base] = table
+    return table
+
+
+def _unit_circle(args: range, base: int, trig: str) -> List[array]:
+    """sin and cos columns of `2 * pi * vdc(k, base)` for the `k` in `args`
+
+    With `trig == "table"` every index is split as `k = hi * span + lo`, so that
+    `vdc(k) = vdc(lo) + vdc(hi) / span`. The angle of `lo` comes from a cached
+    table and the angle of `hi` is evaluated once per run of equal `hi`; the two
+    are combined by the angle-addition formulas. For consecutive indices that is
+    one pair of trigonometric calls per `span` points. As each point is a single
+    product of two independently evaluated rotations, the error does not grow
+    along the sequence: every coordinate stays within a few units of 2**-52 of
+    the `"exact"` result (at most 2e-15 in practice).
+    """
+    if trig == "exact":
+        thetas = [v * TWO_PI for v in vdc_batch(args, base)]
+        return [array("d", map(sin, thetas)), array("d", map(cos, thetas))]
+    lo_sin, lo_cos = _trig_table(base)
+    cols = _native_columns("circle_table_fill", 2, args, base, tables=(lo_sin, lo_cos))
+    if cols is not None:
+        return cols
+    span = len(lo_sin)
+    s = array("d")
+    c = array("d")
+    if args.step != 1:
+        for k in args:
+            hi, lo = divmod(k, span)
+            theta = vdc(hi, base) / span * TWO_PI
+            sh, ch = sin(theta), cos(theta)
+            ls, lc = lo_sin[lo], lo_cos[lo]
+            s.append(ls * ch + lc * sh)
+            c.append(lc * ch - ls * sh)
+        return [s, c]
+    k, stop = args.start, args.stop
+    while k < stop:
+        hi, lo = divmod(k, span)
+        m = min(span - lo, stop - k)
+        theta = vdc(hi, base) / span * TWO_PI
+        sh, ch = sin(theta), cos(theta)
+        ls, lc = lo_sin[lo : lo + m], lo_cos[lo : lo + m]
+        s.extend(map(add, map(mul, ls, repeat(ch, m)), map(mul, lc, repeat(sh, m))))
+        c.extend(map(sub, map(mul, lc, repeat(ch, m)), map(mul, ls, repeat(sh, m))))
+        k += m
+    return [s, c]
+
+
+class _PointBatch:
+    """Batch interface shared by the multi-dimensional generators
+
+    A subclass provides `dim` and `_columns(n, ks)`, which returns the
+    coordinate columns of the next `n` points (when `ks` is None, advancing the
+    generator) or of the points at the indices in `ks`.
+    """
+
+    dim: int
+    dtype = "d"
+
+    def _columns(self, n: int, ks: Optional[range]) -> List[array]:
+        raise NotImplementedError
+
+    def pop(self) -> List[float]:
+        raise NotImplementedError
+
+    def __iter__(self) -> "_PointBatch":
+        return self
+
+    def __next__(self) -> List[float]:
+        """
+        The `__next__()` function returns `pop()`, so that the generator can be used as an
+        (endless) iterator.
+
+        Examples:
+            >>> from itertools import islice
+            >>> list(islice(Halton([2, 3]), 2))
+            [[0.5, 0.3333333333333333], [0.25, 0.6666666666666666]]
+        """
+        return self.pop()
+
+    def chunks(
+        self, chunk_size: int, order: str = "C", dtype: str = "d"
+    ) -> Iterator[PointBlock]:
+        """
+        The `chunks()` function yields the sequence in consecutive blocks of `chunk_size` points.
+
+        One flat array of `chunk_size * dim` values is allocated up front and refilled for
+        every block, so memory use stays constant no matter how many blocks are consumed. The same
+        buffer object is yielded each time; copy it if a block has to outlive the next iteration.
+        The generator is endless.
+
+        :param chunk_size: The `chunk_size` parameter is the number of points per block
+
+        :type chunk_size: int
+
+        :param order: The `order` parameter selects the layout of each block, either "C" (row-major)
+        or "F" (column-major), defaults to "C"
+
+        :type order: str (optional)
+
+        :param dtype: The `dtype` parameter is "d" (float64) or "f" (float32), see the module
+        documentation, defaults to "d"
+
+        :type dtype: str (optional)
+
+        Examples:
+            >>> blocks = HaltonN(3, [2, 3, 5]).chunks(1)
+            >>> next(blocks).tolist()
+            [0.5, 0.3333333333333333, 0.2]
+            >>> next(blocks).tolist()
+            [0.25, 0.6666666666666666, 0.4]
+        """
+        buf = _zeros(dtype, (chunk_size, self.dim), order)
+        while True:
+            self.fill(buf, order)
+            yield buf
+
+    def pop_batch(self, n: int, order: str = "C", dtype: str = "d") -> PointBlock:
+        """
+        The `pop_batch()` function generates the next `n` points of the sequence at once.
+
+        :param n: The parameter `n` is the number of points to generate
+
+        :type n: int
+
+        :param order: The `order` parameter selects the layout of the `(n, dim)` result, either "C"
+        (row-major) or "F" (column-major), defaults to "C"
+
+        :type order: str (optional)
+
+        :param dtype: The `dtype` parameter is "d" (float64) or "f" (float32), see the module
+        documentation, defaults to "d"
+
+        :type dtype: str (optional)
 
+        :return: The function `pop_batch` returns a `block.PointBlock` of shape `(n, dim)`, a flat
+        `array("d")` (or `array("f")`) of `n * dim` values that exports its memory without
+        copying through the buffer protocol and DLPack.
 
-class Halton:
+        Examples:
+            >>> hgen = Halton([2, 3])
+            >>> hgen.pop_batch(2).tolist()
+            [0.5, 0.3333333333333333, 0.25, 0.6666666666666666]
+            >>> hgen = HaltonN(3, [2, 3, 5])
+            >>> hgen.pop_batch(2, "F").tolist()
+            [0.5, 0.25, 0.3333333333333333, 0.6666666666666666, 0.2, 0.4]
+        """
+        res = _zeros(dtype, (n, self.dim), order)
+        self.fill(res, order)
+        return res
+
+    def fill(self, out, order: str = "C", start: Optional[int] = None) -> None:
+        """
+        The `fill()` function writes consecutive points of the sequence into a caller-supplied buffer.
+
+        Each coordinate is generated in one batch pass and stored directly into `out`, so no list or
+        float object is created per point.
+
+        :param out: The parameter `out` is a writable, C-contiguous buffer of float64 or float32
+        values holding `(n, dim)` values, for example an `array("d")` or a `numpy.ndarray`. The number of points `n`
+        is derived from its size. A Fortran-ordered `(n, dim)` numpy array can be filled through its
+        (C-contiguous) transpose together with `order="F"`.
+
+        :param order: The `order` parameter selects the layout of `out`, either "C" (row-major) or "F"
+        (column-major), defaults to "C"
+
+        :type order: str (optional)
+
+        :param start: The `start` parameter selects random access: when given, `out` receives
+        `slice(start, start + n)` and the state of the generator is left unchanged. By default the
+        next points are written and the generator is advanced, as with `pop_batch()`.
+
+        :type start: int (optional)
+
+        Examples:
+            >>> hgen = HaltonN(3, [2, 3, 5])
+            >>> out = array("d", bytes(8 * 6))
+            >>> hgen.fill(out)
+            >>> out.tolist()
+            [0.5, 0.3333333333333333, 0.2, 0.25, 0.6666666666666666, 0.4]
+        """
+        view = _flat_view(out, "df")
+        n = _rows(view, self.dim)
+        ks = None if start is None else range(start, start + n)
+        for j, col in enumerate(self._columns(n, ks)):
+            _write_column(view, col, j, self.dim, order)
+
+    def slice(
+        self,
+        start: int,
+        stop: int,
+        step: int = 1,
+        order: str = "C",
+        dtype: str = "d",
+    ) -> PointBlock:
+        """
+        The `slice()` function returns `at(i)` for every `i` in `range(start, stop, step)`.
+
+        This is exactly what `reseed(start)` followed by `stop - start` calls to `pop()` would return
+        (for `step == 1`), computed directly without generating the preceding points, so that
+        disjoint blocks of one sequence can be produced independently. The state of the generator is
+        not changed.
+
+        :return: The function `slice` returns a `block.PointBlock` of shape `(n, dim)`, a flat
+        `array("d")` (or `array("f")` for `dtype="f"`) holding the points in the layout
+        selected by `order`.
+
+        Examples:
+            >>> hgen = Halton([2, 3])
+            >>> hgen.slice(1, 3).tolist()
+            [0.25, 0.6666666666666666, 0.75, 0.1111111111111111]
+        """
+        ks = range(start, stop, step)
+        res = _zeros(dtype, (len(ks), self.dim), order)
+        view = memoryview(res)
+        for j, col in enumerate(self._columns(len(ks), ks)):
+            _write_column(view, col, j, self.dim, order)
+        view.release()
+        return res
+
+
+class Halton(_PointBatch):
     """Halton sequence generator
 
     The `Halton` class is a sequence generator that generates points in a
@@ -147,8 +1161,9 @@ class Halton:
 
     vdc0: VdCorput
     vdc1: VdCorput
+    dim = 2
 
-    def __init__(self, base: Sequence[int]) -> None:
+    def __init__(self, base: Sequence[int], leap: int = 1, offset: int = 0) -> None:
         """
         The `__init__()` function is a constructor for the `Halton` class that initializes two `VdCorput`
         objects with the given bases.
@@ -159,9 +1174,19 @@ class Halton:
         second component
 
         :type base: Sequence[int]
+
+        :param leap: The `leap` parameter is the distance between the indices of the substream,
+        see `VdCorput`, defaults to 1
+
+        :type leap: int (optional)
+
+        :param offset: The `offset` parameter is the index of the first point of the substream,
+        defaults to 0
+
+        :type offset: int (optional)
         """
-        self.vdc0 = VdCorput(base[0])
-        self.vdc1 = VdCorput(base[1])
+        self.vdc0 = VdCorput(base[0], leap, offset)
+        self.vdc1 = VdCorput(base[1], leap, offset)
 
     def pop(self) -> List[float]:
         """
@@ -183,6 +1208,20 @@ class Halton:
         """
         return [self.vdc0.pop(), self.vdc1.pop()]
 
+    def _columns(self, n: int, ks: Optional[range]) -> List[array]:
+        return [_coords(self.vdc0, n, ks), _coords(self.vdc1, n, ks)]
+
+    def at(self, index: int) -> List[float]:
+        """
+        The `at()` function returns the point that `pop()` returns right after `reseed(index)`.
+
+        Examples:
+            >>> hgen = Halton([2, 3])
+            >>> hgen.at(1)
+            [0.25, 0.6666666666666666]
+        """
+        return [self.vdc0.at(index), self.vdc1.at(index)]
+
     def reseed(self, seed: int) -> None:
         """
         The `reseed` function resets the state of a sequence generator to a specific seed value.
@@ -196,7 +1235,7 @@ class Halton:
         self.vdc1.reseed(seed)
 
 
-class Circle:
+class Circle(_PointBatch):
     """Circle sequence generator
 
     Examples:
@@ -210,15 +1249,43 @@ class Circle:
     """
 
     vdc: VdCorput
+    trig: str
+    dim = 2
 
-    def __init__(self, base: int) -> None:
+    def __init__(
+        self, base: int, trig: str = "exact", leap: int = 1, offset: int = 0
+    ) -> None:
         """
         The function initializes an instance of the class with a given base.
 
         :param base: The `base` parameter is an integer that represents the base of the Van der Corput sequence
         :type base: int
+
+        :param trig: The `trig` parameter selects how the batch functions (`pop_batch()`, `fill()`,
+        `slice()` and `chunks()`) evaluate sine and cosine: "exact" calls them for every point, just
+        like `pop()`; "table" combines cached angle-addition tables, which replaces nearly all
+        trigonometric calls and agrees with "exact" to within a few units of 2**-52, defaults to
+        "exact"
+
+        :type trig: str (optional)
+
+        :param leap: The `leap` parameter is the distance between the indices of the substream,
+        see `VdCorput`, defaults to 1
+
+        :type leap: int (optional)
+
+        :param offset: The `offset` parameter is the index of the first point of the substream,
+        defaults to 0
+
+        :type offset: int (optional)
+
+        Examples:
+            >>> cgen = Circle(3, trig="table")
+            >>> [round(x, 12) for x in cgen.pop_batch(2)]
+            [0.866025403784, -0.5, -0.866025403784, -0.5]
         """
-        self.vdc = VdCorput(base)
+        self.vdc = VdCorput(base, leap, offset)
+        self.trig = _check_trig(trig)
 
     def pop(self) -> List[float]:
         """
@@ -241,6 +1308,29 @@ class Circle:
         theta = self.vdc.pop() * TWO_PI  # map to [0, 2*pi]
         return [sin(theta), cos(theta)]
 
+    def _columns(self, n: int, ks: Optional[range]) -> List[array]:
+        return self._circle(_arguments(self.vdc, n, ks))
+
+    def _circle(self, args: range) -> List[array]:
+        """Coordinate columns of the points for the `vdc()` arguments `args`"""
+        if self.trig == "exact":
+            cols = _native_columns("circle_fill", 2, args, self.vdc.base)
+            if cols is not None:
+                return cols
+        return _unit_circle(args, self.vdc.base, self.trig)
+
+    def at(self, index: int) -> List[float]:
+        """
+        The `at()` function returns the point that `pop()` returns right after `reseed(index)`.
+
+        Examples:
+            >>> cgen = Circle(2)
+            >>> cgen.at(1)
+            [1.0, 6.123233995736766e-17]
+        """
+        theta = self.vdc.at(index) * TWO_PI
+        return [sin(theta), cos(theta)]
+
     # [allow(dead_code)]
     def reseed(self, seed: int) -> None:
         """
@@ -254,7 +1344,7 @@ class Circle:
         self.vdc.reseed(seed)
 
 
-class Sphere:
+class Sphere(_PointBatch):
     """Sphere sequence generator
 
     Examples:
@@ -270,8 +1360,15 @@ class Sphere:
 
     vdc: VdCorput
     cirgen: Circle
-
-    def __init__(self, base: Sequence[int]) -> None:
+    dim = 3
+
+    def __init__(
+        self,
+        base: Sequence[int],
+        trig: str = "exact",
+        leap: int = 1,
+        offset: int = 0,
+    ) -> None:
         """
         The function initializes the `vdc` and `cirgen` attributes with the first and second elements of the
         `base` list, respectively.
@@ -281,9 +1378,29 @@ class Sphere:
         initialize a `Circle` object
 
         :type base: Sequence[int]
+
+        :param trig: The `trig` parameter selects the trigonometric mode of the batch functions,
+        see `Circle`, defaults to "exact"
+
+        :type trig: str (optional)
+
+        :param leap: The `leap` parameter is the distance between the indices of the substream,
+        see `VdCorput`, defaults to 1
+
+        :type leap: int (optional)
+
+        :param offset: The `offset` parameter is the index of the first point of the substream,
+        defaults to 0
+
+        :type offset: int (optional)
+
+        Examples:
+            >>> subs = [Sphere([2, 3], leap=5, offset=j) for j in range(5)]
+            >>> subs[3].pop() == Sphere([2, 3]).at(3) and subs[3].at(2) == Sphere([2, 3]).at(13)
+            True
         """
-        self.vdc = VdCorput(base[0])
-        self.cirgen = Circle(base[1])
+        self.vdc = VdCorput(base[0], leap, offset)
+        self.cirgen = Circle(base[1], trig, leap, offset)
 
     def pop(self) -> List[float]:
         """
@@ -303,6 +1420,38 @@ class Sphere:
         [c, s] = self.cirgen.pop()
         return [sinphi * c, sinphi * s, cosphi]
 
+    def _columns(self, n: int, ks: Optional[range]) -> List[array]:
+        args = _arguments(self.vdc, n, ks)
+        circle_args = _arguments(self.cirgen.vdc, n, ks)
+        if args == circle_args:
+            bases = (self.vdc.base, self.cirgen.vdc.base)
+            if self.cirgen.trig == "exact":
+                cols = _native_columns("sphere_fill", 3, args, *bases)
+            else:
+                tables = _trig_table(bases[1])
+                cols = _native_columns(
+                    "sphere_table_fill", 3, args, *bases, tables=tables
+                )
+            if cols is not None:
+                return cols
+        cosphi = [2.0 * v - 1.0 for v in vdc_batch(args, self.vdc.base)]
+        sinphi = [sqrt(1.0 - c * c) for c in cosphi]
+        c, s = self.cirgen._circle(circle_args)
+        return [
+            array("d", map(mul, sinphi, c)),
+            array("d", map(mul, sinphi, s)),
+            array("d", cosphi),
+        ]
+
+    def at(self, index: int) -> List[float]:
+        """
+        The `at()` function returns the point that `pop()` returns right after `reseed(index)`.
+        """
+        cosphi = 2.0 * self.vdc.at(index) - 1.0
+        sinphi = sqrt(1.0 - cosphi * cosphi)
+        [c, s] = self.cirgen.at(index)
+        return [sinphi * c, sinphi * s, cosphi]
+
     def reseed(self, seed: int) -> None:
         """
         The `reseed` function resets the state of a sequence generator to a specific seed value.
@@ -317,14 +1466,22 @@ class Sphere:
 
 
 # S(3) sequence generator by Hopf
-class Sphere3Hopf:
+class Sphere3Hopf(_PointBatch):
     """Sphere3Hopf sequence generator"""
 
     vdc0: VdCorput
     vdc1: VdCorput
     vdc2: VdCorput
-
-    def __init__(self, base: Sequence[int]) -> None:
+    trig: str
+    dim = 4
+
+    def __init__(
+        self,
+        base: Sequence[int],
+        trig: str = "exact",
+        leap: int = 1,
+        offset: int = 0,
+    ) -> None:
         """
         The function initializes three VdCorput objects with the values from the base list.
 
@@ -333,10 +1490,27 @@ class Sphere3Hopf:
         `self.vdc0`, the second integer is used to initialize `self.vdc1
 
         :type base: Sequence[int]
+
+        :param trig: The `trig` parameter selects the trigonometric mode of the batch functions,
+        see `Circle`. With "table" the angle `phi + psy` is formed by angle addition as well, which
+        roughly doubles the error bound, defaults to "exact"
+
+        :type trig: str (optional)
+
+        :param leap: The `leap` parameter is the distance between the indices of the substream,
+        see `VdCorput`, defaults to 1
+
+        :type leap: int (optional)
+
+        :param offset: The `offset` parameter is the index of the first point of the substream,
+        defaults to 0
+
+        :type offset: int (optional)
         """
-        self.vdc0 = VdCorput(base[0])
-        self.vdc1 = VdCorput(base[1])
-        self.vdc2 = VdCorput(base[2])
+        self.vdc0 = VdCorput(base[0], leap, offset)
+        self.vdc1 = VdCorput(base[1], leap, offset)
+        self.vdc2 = VdCorput(base[2], leap, offset)
+        self.trig = _check_trig(trig)
 
     def pop(self) -> List[float]:
         """
@@ -363,6 +1537,69 @@ class Sphere3Hopf:
             sin_eta * sin(phi + psy),
         ]
 
+    def _columns(self, n: int, ks: Optional[range]) -> List[array]:
+        vdcs = [self.vdc0, self.vdc1, self.vdc2]
+        args = [_arguments(vdc, n, ks) for vdc in vdcs]
+        if self.trig == "table":
+            return self._table_columns(args)
+        if args[0] == args[1] == args[2]:
+            bases = [vdc.base for vdc in vdcs]
+            cols = _native_columns("sphere3hopf_fill", 4, args[0], *bases)
+            if cols is not None:
+                return cols
+        phi = [v * TWO_PI for v in vdc_batch(args[0], self.vdc0.base)]
+        psy = [v * TWO_PI for v in vdc_batch(args[1], self.vdc1.base)]
+        vd = vdc_batch(args[2], self.vdc2.base)
+        cos_eta = [sqrt(v) for v in vd]
+        sin_eta = [sqrt(1.0 - v) for v in vd]
+        phi_psy = list(map(add, phi, psy))
+        return [
+            array("d", map(mul, cos_eta, map(cos, psy))),
+            array("d", map(mul, cos_eta, map(sin, psy))),
+            array("d", map(mul, sin_eta, map(cos, phi_psy))),
+            array("d", map(mul, sin_eta, map(sin, phi_psy))),
+        ]
+
+    def _table_columns(self, args: List[range]) -> List[array]:
+        if args[0] == args[1] == args[2]:
+            bases = [vdc.base for vdc in (self.vdc0, self.vdc1, self.vdc2)]
+            tables = _trig_table(bases[0]) + _trig_table(bases[1])
+            cols = _native_columns(
+                "sphere3hopf_table_fill", 4, args[0], *bases, tables=tables
+            )
+            if cols is not None:
+                return cols
+        sin_phi, cos_phi = _unit_circle(args[0], self.vdc0.base, "table")
+        sin_psy, cos_psy = _unit_circle(args[1], self.vdc1.base, "table")
+        vd = vdc_batch(args[2], self.vdc2.base)
+        cos_eta = [sqrt(v) for v in vd]
+        sin_eta = [sqrt(1.0 - v) for v in vd]
+        # cos(phi + psy) and sin(phi + psy) by angle addition
+        cos_sum = map(sub, map(mul, cos_phi, cos_psy), map(mul, sin_phi, sin_psy))
+        sin_sum = map(add, map(mul, sin_phi, cos_psy), map(mul, cos_phi, sin_psy))
+        return [
+            array("d", map(mul, cos_eta, cos_psy)),
+            array("d", map(mul, cos_eta, sin_psy)),
+            array("d", map(mul, sin_eta, cos_sum)),
+            array("d", map(mul, sin_eta, sin_sum)),
+        ]
+
+    def at(self, index: int) -> List[float]:
+        """
+        The `at()` function returns the point that `pop()` returns right after `reseed(index)`.
+        """
+        phi = self.vdc0.at(index) * TWO_PI
+        psy = self.vdc1.at(index) * TWO_PI
+        vd = self.vdc2.at(index)
+        cos_eta = sqrt(vd)
+        sin_eta = sqrt(1.0 - vd)
+        return [
+            cos_eta * cos(psy),
+            cos_eta * sin(psy),
+            sin_eta * cos(phi + psy),
+            sin_eta * sin(phi + psy),
+        ]
+
     def reseed(self, seed: int) -> None:
         """
         The `reseed` function resets the state of a sequence generator to a specific seed value.
@@ -377,7 +1614,7 @@ class Sphere3Hopf:
         self.vdc2.reseed(seed)
 
 
-class HaltonN:
+class HaltonN(_PointBatch):
     """HaltonN sequence generator
 
     Examples:
@@ -392,7 +1629,9 @@ class HaltonN:
 
     vdcs: List[VdCorput]
 
-    def __init__(self, n: int, base: Sequence[int]) -> None:
+    def __init__(
+        self, n: int, base: Sequence[int], leap: int = 1, offset: int = 0
+    ) -> None:
         """
         The function initializes a list of VdCorput objects using the given base sequence.
 
@@ -405,8 +1644,41 @@ class HaltonN:
         analysis and Monte Carlo methods. In this code, `base` is used to initialize a list
 
         :type base: Sequence[int]
+
+        :param leap: The `leap` parameter is the distance between the indices of the substream,
+        see `VdCorput`; a leap that is a multiple of any of the bases spoils that coordinate,
+        defaults to 1
+
+        :type leap: int (optional)
+
+        :param offset: The `offset` parameter is the index of the first point of the substream,
+        defaults to 0
+
+        :type offset: int (optional)
+
+        Examples:
+            >>> hgen = HaltonN(3, [2, 3, 5], leap=7, offset=1)
+            >>> hgen.pop_batch(2).tolist() == HaltonN(3, [2, 3, 5]).slice(1, 9, 7).tolist()
+            True
+        """
+        self.vdcs = [VdCorput(base[i], leap, offset) for i in range(n)]
+
+    @classmethod
+    def with_dimension(cls, n: int) -> "HaltonN":
         """
-        self.vdcs = [VdCorput(base[i]) for i in range(n)]
+        The `with_dimension()` function creates an `n`-dimensional generator whose bases are the
+        first `n` primes, see `primes()`.
+
+        :param n: The parameter `n` is the number of dimensions
+
+        :type n: int
+
+        Examples:
+            >>> hgen = HaltonN.with_dimension(4)
+            >>> [vdc.base for vdc in hgen.vdcs]
+            [2, 3, 5, 7]
+        """
+        return cls(n, primes(n))
 
     def pop(self) -> List[float]:
         """
@@ -428,6 +1700,24 @@ class HaltonN:
         """
         return [vdc.pop() for vdc in self.vdcs]
 
+    @property
+    def dim(self) -> int:
+        return len(self.vdcs)
+
+    def _columns(self, n: int, ks: Optional[range]) -> List[array]:
+        return [_coords(vdc, n, ks) for vdc in self.vdcs]
+
+    def at(self, index: int) -> List[float]:
+        """
+        The `at()` function returns the point that `pop()` returns right after `reseed(index)`.
+
+        Examples:
+            >>> hgen = HaltonN(3, [2, 3, 5])
+            >>> hgen.at(1)
+            [0.25, 0.6666666666666666, 0.4]
+        """
+        return [vdc.at(index) for vdc in self.vdcs]
+
     def reseed(self, seed: int) -> None:
         """
         The `reseed` function resets the state of a sequence generator to a specific seed value.
@@ -441,6 +1731,11 @@ class HaltonN:
             vdc.reseed(seed)
 
 
+if _native is not None:
+    # the compiled kernel returns bit-for-bit the same values
+    vdc = _native.vdc  # noqa: F811
+
+
 # First 1000 prime numbers
 # [allow(dead_code)]
 PRIME_TABLE: List[int] = [
@@ -1447,6 +2742,53 @@ PRIME_TABLE: List[int] = [
 ]
 
 
+# All primes found so far, in increasing order
+_prime_cache: List[int] = list(PRIME_TABLE)
+
+# Maximum length of a segment of the prime sieve
+_SIEVE_SEGMENT = 2**20
+
+
+def _sieve_segment(lo: int, hi: int) -> List[int]:
+    """The primes in `[lo, hi)`, given the primes below `lo` with `hi <= lo**2`"""
+    flags = bytearray(b"\x01") * (hi - lo)
+    for p in _prime_cache:
+        if p * p >= hi:
+            break
+        first = max(p * p, -(-lo // p) * p) - lo
+        flags[first::p] = bytes(len(range(first, hi - lo, p)))
+    return list(compress(range(lo, hi), flags))
+
+
+def primes(n: int) -> List[int]:
+    """
+    The `primes()` function returns the first `n` primes.
+
+    The first 1000 primes come from `PRIME_TABLE`; more are found by a segmented sieve of
+    Eratosthenes and cached, so that later calls cost no more than a copy of the result.
+
+    :param n: The parameter `n` is the number of primes
+
+    :type n: int
+
+    Examples:
+        >>> primes(5)
+        [2, 3, 5, 7, 11]
+        >>> primes(10000)[-1]
+        104729
+    """
+    if n < 0:
+        raise ValueError("n must be non-negative")
+    if n > len(_prime_cache):
+        # p_n < n * (log(n) + log(log(n))) for n >= 6
+        bound = int(n * (log(n) + log(log(n)))) + 1
+        while len(_prime_cache) < n:
+            lo = _prime_cache[-1] + 1
+            hi = min(max(bound, lo + 1), lo + _SIEVE_SEGMENT)
+            _prime_cache.extend(_sieve_segment(lo, hi))
+    return _prime_cache[:n]
+
+
 if __name__ == "__main__":
     import doctest
 
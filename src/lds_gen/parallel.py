@@ -0,0 +1,109 @@
+"""
+This module contains a deterministic multi-process driver for the sequence generators
+"""
+
+import os
+from concurrent.futures import ProcessPoolExecutor
+from multiprocessing import RawArray
+from typing import List, Optional, Tuple
+
+from .base import layout
+from .lds import get_engine, set_engine
+
+# Shared output buffer of the current worker process, set by `_attach`
+_shared: Optional[memoryview] = None
+
+
+def _attach(raw, typecode: str, engine: str) -> None:
+    """Initializer of the worker processes: map the shared output buffer and select the
+    engine of the parent, which a spawned worker does not inherit"""
+    global _shared
+    _shared = memoryview(raw).cast("B").cast(typecode)
+    set_engine(engine)
+
+
+def _fill_chunk(gen, lo: int, hi: int, start: int) -> None:
+    """Write the points `lo` to `hi` (relative to `start`) into the shared buffer"""
+    assert _shared is not None
+    dim = gen.dim
+    gen.fill(_shared[lo * dim : hi * dim], start=start + lo)
+
+
+def _chunks(n: int, size: int) -> List[Tuple[int, int]]:
+    return [(lo, min(lo + size, n)) for lo in range(0, n, size)]
+
+
+def generate_parallel(
+    gen,
+    n: int,
+    workers: Optional[int] = None,
+    start: int = 0,
+    chunk_size: Optional[int] = None,
+) -> memoryview:
+    """Generate a block of points on several processes
+
+    The index range `[start, start + n)` is split into chunks that are
+    generated independently with the random-access `fill(out, start=...)` of
+    `gen` and stored into disjoint slices of one shared output buffer. Since
+    every point depends on its index only, the result is identical to calling
+    `gen.reseed(start)` followed by `n` calls to `gen.pop()`, no matter how
+    many workers are used. The state of `gen` is not changed.
+
+    :param gen: The `gen` parameter is a `base.SequenceGenerator`, e.g. `lds.HaltonN`,
+    `lds.Sphere`, `lds.Sphere3Hopf` or `ilds.Halton`
+
+    :param n: The parameter `n` is the number of points to generate
+
+    :type n: int
+
+    :param workers: The `workers` parameter is the number of worker processes, defaults to the number
+    of CPUs
+
+    :type workers: int (optional)
+
+    :param start: The `start` parameter is the index of the first point, as passed to `reseed()`,
+    defaults to 0
+
+    :type start: int (optional)
+
+    :param chunk_size: The `chunk_size` parameter is the number of points per task, defaults to a
+    size that gives each worker about four chunks
+
+    :type chunk_size: int (optional)
+
+    :return: The function `generate_parallel` returns a flat memoryview of `n * dim` values in
+    row-major order, holding float64 values for the `lds` generators and unsigned integers of
+    the generator's `typecode` for the `ilds` generators.
+
+    Examples:
+        >>> from lds_gen.lds import HaltonN
+        >>> res = generate_parallel(HaltonN(3, [2, 3, 5]), 2, workers=2)
+        >>> res.tolist()
+        [0.5, 0.3333333333333333, 0.2, 0.25, 0.6666666666666666, 0.4]
+    """
+    dim, typecode = layout(gen)
+    if workers is None:
+        workers = os.cpu_count() or 1
+    if chunk_size is None:
+        chunk_size = max(1, -(-n // (4 * workers)))
+    raw = RawArray(typecode, n * dim)
+    out = memoryview(raw).cast("B").cast(typecode)
+    if workers <= 1 or n <= chunk_size:
+        gen.fill(out, start=start)
+        return out
+    with ProcessPoolExecutor(
+        workers, initializer=_attach, initargs=(raw, typecode, get_engine())
+    ) as pool:
+        tasks = [
+            pool.submit(_fill_chunk, gen, lo, hi, start)
+            for lo, hi in _chunks(n, chunk_size)
+        ]
+        for task in tasks:
+            task.result()
+    return out
+
+
+if __name__ == "__main__":
+    import doctest
+
+    doctest.testmod()
@@ -0,0 +1,208 @@
+"""
+This module contains a product-space generator composed of other generators
+
+A `Product` of generators yields points whose coordinates are those of its components at the
+same index, one after another, e.g. `[HaltonN(3), Sphere, Circle]` gives 3 + 3 + 2 = 8
+coordinates per point. The batch functions compute the coordinate columns of all components
+in one pass (with the compiled kernels where available) and store each column directly into
+the one output buffer, so that no per-component blocks or point lists are built in between.
+
+`Product.auto()` builds the components from their classes and assigns them consecutive,
+distinct prime bases; otherwise the components must not share a van der Corput base, which
+would make their coordinates correlated.
+"""
+
+from array import array
+from typing import List, Optional, Sequence, Tuple, Type, Union
+
+from .lds import (
+    Circle,
+    Halton,
+    HaltonN,
+    IncrementalVdCorput,
+    Sphere,
+    Sphere3Hopf,
+    VdCorput,
+    _PointBatch,
+    primes,
+)
+from .sphere_n import SphereN
+
+# Number of bases taken by the components with a fixed dimension
+_FIXED_BASES = {VdCorput: 1, Circle: 1, Halton: 2, Sphere: 2, Sphere3Hopf: 3}
+
+# Components that take a number of bases, passed as `(cls, n)`
+_SIZED = (HaltonN, SphereN)
+
+Component = Union[Type, Tuple[Type, int]]
+
+
+def _build(cls: Type, bases: List[int], trig: str):
+    """The component `cls` with the given bases"""
+    if cls is VdCorput:
+        return VdCorput(bases[0])
+    if cls is Circle:
+        return Circle(bases[0], trig)
+    if cls is Halton:
+        return Halton(bases)
+    if cls in (Sphere, Sphere3Hopf, SphereN):
+        return cls(bases, trig)
+    return HaltonN(len(bases), bases)
+
+
+def radical_bases(gen) -> List[int]:
+    """
+    The `radical_bases()` function returns the bases of the plain van der Corput sequences that
+    drive a generator, in the order of its attributes.
+
+    Examples:
+        >>> radical_bases(Sphere([5, 7])), radical_bases(HaltonN(2, [2, 3]))
+        ([5, 7], [2, 3])
+    """
+    if type(gen) in (VdCorput, IncrementalVdCorput):
+        return [gen.base]
+    res: List[int] = []
+    for value in vars(gen).values():
+        values = value if isinstance(value, list) else [value]
+        for item in values:
+            if isinstance(item, (VdCorput, _PointBatch)):
+                res += radical_bases(item)
+    return res
+
+
+class Product(_PointBatch):
+    """Product-space sequence generator
+
+    Examples:
+        >>> pgen = Product.auto([(HaltonN, 3), Sphere, Circle])
+        >>> pgen.dim, radical_bases(pgen)
+        (8, [2, 3, 5, 7, 11, 13])
+        >>> pgen.reseed(0)
+        >>> pt = pgen.pop()
+        >>> pt[:3], round(sum(x * x for x in pt[3:6]), 12)
+        ([0.5, 0.3333333333333333, 0.2], 1.0)
+        >>> pgen.pop_batch(2).tolist() == pgen.slice(1, 3).tolist()
+        True
+    """
+
+    components: List
+
+    def __init__(self, components: Sequence) -> None:
+        """
+        The function composes the generators `components`, which advance together.
+
+        :param components: The `components` parameter holds at least one `lds` (or `sobol`,
+        `kronecker`, ...) float generator with a batch interface, or `VdCorput`, without shared
+        van der Corput bases
+
+        :type components: Sequence
+        """
+        if not components:
+            raise ValueError("a product needs at least one component")
+        for gen in components:
+            if not isinstance(gen, (VdCorput, _PointBatch)):
+                raise TypeError(f"{type(gen).__name__} cannot be a product component")
+        bases = [b for gen in components for b in radical_bases(gen)]
+        if len(set(bases)) != len(bases):
+            raise ValueError(f"the components share van der Corput bases: {bases}")
+        self.components = list(components)
+
+    @classmethod
+    def auto(
+        cls, spec: Sequence[Component], trig: str = "exact", skip: int = 0
+    ) -> "Product":
+        """
+        The `auto()` function builds the components from their classes with consecutive primes
+        as bases.
+
+        :param spec: The `spec` parameter holds the components: `VdCorput`, `Circle`, `Halton`,
+        `Sphere` or `Sphere3Hopf`, or `(HaltonN, n)` and `(SphereN, n)` for `n` bases
+
+        :type spec: Sequence
+
+        :param trig: The `trig` parameter is the trigonometric mode of the batch functions of
+        the spherical components, see `lds.Circle`, defaults to "exact"
+
+        :type trig: str (optional)
+
+        :param skip: The `skip` parameter is the number of leading primes not to use, defaults
+        to 0
+
+        :type skip: int (optional)
+        """
+        sizes: List[Tuple[Type, int]] = []
+        for item in spec:
+            if isinstance(item, tuple):
+                kind, n = item
+                if kind not in _SIZED:
+                    raise TypeError(f"{kind.__name__} takes no number of bases")
+            elif item in _FIXED_BASES:
+                kind, n = item, _FIXED_BASES[item]
+            else:
+                raise TypeError(f"cannot build a product component from {item!r}")
+            sizes.append((kind, n))
+        bases = primes(skip + sum(n for _, n in sizes))[skip:]
+        components = []
+        for kind, n in sizes:
+            components.append(_build(kind, bases[:n], trig))
+            bases = bases[n:]
+        return cls(components)
+
+    @property
+    def dim(self) -> int:
+        return sum(gen.dim for gen in self.components)
+
+    def pop(self) -> List[float]:
+        """
+        The `pop()` function returns the next point, the next points of all components joined.
+        """
+        res: List[float] = []
+        for gen in self.components:
+            pt = gen.pop()
+            if isinstance(pt, list):
+                res += pt
+            else:
+                res.append(pt)
+        return res
+
+    def _columns(self, n: int, ks: Optional[range]) -> List[array]:
+        cols: List[array] = []
+        for gen in self.components:
+            if isinstance(gen, _PointBatch):
+                cols += gen._columns(n, ks)
+            elif ks is None:
+                cols.append(gen.pop_batch(n))
+            else:
+                cols.append(gen.slice(ks.start, ks.stop, ks.step))
+        return cols
+
+    def at(self, index: int) -> List[float]:
+        """
+        The `at()` function returns the point that `pop()` returns right after `reseed(index)`.
+        """
+        res: List[float] = []
+        for gen in self.components:
+            pt = gen.at(index)
+            if isinstance(pt, list):
+                res += pt
+            else:
+                res.append(pt)
+        return res
+
+    def reseed(self, seed: int) -> None:
+        """
+        The `reseed` function resets the state of a sequence generator to a specific seed value.
+
+        :param seed: The `seed` parameter is an integer value that is used to reset the state of the
+        sequence generator. It determines the starting point of the sequence generation
+
+        :type seed: int
+        """
+        for gen in self.components:
+            gen.reseed(seed)
+
+
+if __name__ == "__main__":
+    import doctest
+
+    doctest.testmod()
@@ -0,0 +1,299 @@
+"""
+Randomized (scrambled) low-discrepancy sequence generators
+
+Scrambling applies a random bijection to the base-`b` digits of every index. It keeps the
+stratification of the sequence but breaks the correlation between the dimensions of Halton
+points with large bases, and independently seeded copies give independent randomizations for
+error estimates. Three methods are available:
+
+- "permutation": every digit position has its own random permutation of the digit values
+  (random digit scrambling);
+- "linear": the digit vector `d` becomes `L d + g (mod b)` with a random lower-triangular
+  matrix `L` with invertible diagonal and a random digit vector `g` (Matousek's linear
+  scrambling);
+- "shift": every digit `d` becomes `d + g (mod b)` with a random digit `g` per position
+  (random digital shift).
+
+Only the lowest `digits` digits of an index take part; by default as many as `b**digits`
+stays below 2**53, so that each value is a single correctly rounded division. Permutation
+tables take `digits * b` entries of the narrowest unsigned typecode that holds the digits;
+the linear method stores only `digits * (digits + 1) / 2` matrix entries, which makes it
+the better choice for many dimensions with large bases.
+"""
+
+from array import array
+from math import gcd
+from operator import add, mul
+from random import Random
+from typing import List, Optional, Sequence
+
+from .block import PointBlock
+from .ilds import uint_typecode
+from .lds import HaltonN, VdCorput, _arguments, _digit_terms, _into, _values, primes
+
+try:
+    from . import _native
+except ImportError:  # pragma: no cover
+    _native = None
+
+SCRAMBLE_METHODS = ("permutation", "linear", "shift")
+
+# Largest denominator for which the scrambled values are exact doubles
+_EXACT_SCALE = 2**53
+
+
+def _max_digits(base: int) -> int:
+    """The largest `m >= 1` with `base**m <= 2**53` (1 for larger bases)"""
+    m, power = 1, base
+    while power * base <= _EXACT_SCALE:
+        power *= base
+        m += 1
+    return m
+
+
+class ScrambledVdCorput(VdCorput):
+    """Scrambled Van der Corput sequence generator
+
+    Examples:
+        >>> vgen = ScrambledVdCorput(3, seed=1)
+        >>> vgen.reseed(0)
+        >>> x = vgen.pop()
+        >>> 0.0 <= x < 1.0
+        True
+        >>> vgen.pop_batch(3).tolist() == vgen.slice(1, 4).tolist()
+        True
+    """
+
+    method: str
+    digits: int
+
+    def __init__(
+        self,
+        base: int = 2,
+        method: str = "permutation",
+        seed: Optional[int] = None,
+        digits: Optional[int] = None,
+    ) -> None:
+        """
+        The function initializes the generator with random scrambling tables drawn from
+        `random.Random(seed)`.
+
+        :param base: The `base` parameter is the base of the Van der Corput sequence, defaults to
+        2
+
+        :type base: int (optional)
+
+        :param method: The `method` parameter is one of "permutation", "linear" or "shift", see
+        the module documentation, defaults to "permutation"
+
+        :type method: str (optional)
+
+        :param seed: The `seed` parameter seeds the random scrambling; equal seeds give equal
+        sequences. By default fresh operating system randomness is used
+
+        :type seed: int (optional)
+
+        :param digits: The `digits` parameter is the number of scrambled digits, defaults to the
+        largest number with `base**digits <= 2**53`
+
+        :type digits: int (optional)
+        """
+        super().__init__(base)
+        if method not in SCRAMBLE_METHODS:
+            raise ValueError(
+                f"method must be one of {SCRAMBLE_METHODS}, got {method!r}"
+            )
+        if digits is None:
+            digits = _max_digits(base)
+        elif digits < 1:
+            raise ValueError("digits must be positive")
+        rng = Random(seed)
+        code = uint_typecode(base)
+        if code is None:
+            raise ValueError("base must not exceed 2**64")
+        self.method = method
+        self.digits = digits
+        self._scale = base**digits
+        self._weights = [base ** (digits - 1 - j) for j in range(digits)]
+        self._perms: Optional[array] = None
+        if method == "linear":
+            units = [u for u in range(1, base) if gcd(u, base) == 1]
+            matrix = array(code)
+            for j in range(digits):
+                matrix.extend(rng.randrange(base) for _ in range(j))
+                matrix.append(rng.choice(units))
+            self._matrix = matrix
+            self._shift = array(code, (rng.randrange(base) for _ in range(digits)))
+            starts = [j * (j + 1) // 2 for j in range(digits + 1)]
+            self._rows = [matrix[a:b] for a, b in zip(starts, starts[1:])]
+            return
+        perms = array(code)
+        for _ in range(digits):
+            if method == "permutation":
+                perm = list(range(base))
+                rng.shuffle(perm)
+            else:
+                shift = rng.randrange(base)
+                perm = [(d + shift) % base for d in range(base)]
+            perms.extend(perm)
+        self._perms = perms
+        # _tail[j]: the numerator of the (zero) digits from position j on
+        self._tail = [0] * (digits + 1)
+        for j in reversed(range(digits)):
+            self._tail[j] = self._tail[j + 1] + perms[j * base] * self._weights[j]
+
+    def _numerator(self, k: int) -> int:
+        """The scrambled digits of `k` as the numerator of `vdc() * base**digits`"""
+        base = self.base
+        weights = self._weights
+        if self._perms is not None:
+            perms = self._perms
+            res, j = 0, 0
+            while k != 0 and j < self.digits:
+                k, digit = divmod(k, base)
+                res += perms[j * base + digit] * weights[j]
+                j += 1
+            return res + self._tail[j]
+        digits: List[int] = []
+        while k != 0 and len(digits) < self.digits:
+            k, digit = divmod(k, base)
+            digits.append(digit)
+        res = 0
+        for row, shift, weight in zip(self._rows, self._shift, weights):
+            res += (sum(map(mul, row, digits), shift) % base) * weight
+        return res
+
+    def _batch(self, args: range, out=None) -> array:
+        """The scrambled values for the `vdc()` arguments `args`, written into `out` if given"""
+        if _native is not None and self._scale <= _EXACT_SCALE:
+            res = array("d", bytes(8 * len(args))) if out is None else out
+            start, step, base = args.start, args.step, self.base
+            try:
+                if self._perms is not None:
+                    _native.permute_fill(res, start, step, base, self._perms)
+                else:
+                    tables = (self._matrix, self._shift)
+                    _native.linear_fill(res, start, step, base, *tables)
+                return res
+            except OverflowError:
+                pass
+        scale = self._scale
+        if self._perms is None or args.step != 1 or not args:
+            return _into(out, array("d", [self._numerator(k) / scale for k in args]))
+        # digit position by digit position, as in `lds.vdc_batch`
+        base, perms = self.base, self._perms
+        start, n, last = args.start, len(args), args[-1]
+        res = [0] * n
+        span, j = 1, 0
+        while j < self.digits and span <= last:
+            weight = self._weights[j]
+            vals = [p * weight for p in perms[j * base : (j + 1) * base]]
+            res = list(map(add, res, _digit_terms(start, n, span, vals)))
+            span *= base
+            j += 1
+        tail = self._tail[j]
+        return _into(out, array("d", [(y + tail) / scale for y in res]))
+
+    def pop(self) -> float:
+        """
+        The `pop()` function returns the next value of the scrambled sequence.
+
+        Examples:
+            >>> vgen = ScrambledVdCorput(2, "shift", seed=5, digits=4)
+            >>> [vgen.pop() for _ in range(4)]
+            [0.3125, 0.5625, 0.0625, 0.9375]
+        """
+        self.count += 1
+        return self._numerator(self.count) / self._scale
+
+    def pop_batch(self, n: int, dtype: str = "d") -> PointBlock:
+        """
+        The `pop_batch()` function generates the next `n` values in the sequence at once, exactly
+        as `n` successive calls to `pop()` would.
+        """
+        args = range(self.count + 1, self.count + 1 + n)
+        self.count += n
+        return _values(n, dtype, lambda out: self._batch(args, out))
+
+    def at(self, index: int) -> float:
+        """
+        The `at()` function returns the value that `pop()` returns right after `reseed(index)`.
+        """
+        return self._numerator(index + 1) / self._scale
+
+    def slice(
+        self, start: int, stop: int, step: int = 1, dtype: str = "d"
+    ) -> PointBlock:
+        """
+        The `slice()` function returns `at(i)` for every `i` in `range(start, stop, step)`.
+        """
+        ks = range(start, stop, step)
+        args = range(ks.start + 1, ks.stop + 1, ks.step)
+        return _values(len(args), dtype, lambda out: self._batch(args, out))
+
+
+class ScrambledHaltonN(HaltonN):
+    """Scrambled HaltonN sequence generator
+
+    Every dimension is scrambled independently, with seeds drawn from `random.Random(seed)`.
+
+    Examples:
+        >>> hgen = ScrambledHaltonN(3, [2, 3, 5], seed=42)
+        >>> len(hgen.pop())
+        3
+        >>> hgen.pop_batch(2).tolist() == hgen.slice(1, 3).tolist()
+        True
+    """
+
+    vdcs: List[ScrambledVdCorput]
+
+    def __init__(
+        self,
+        n: int,
+        base: Sequence[int],
+        method: str = "permutation",
+        seed: Optional[int] = None,
+    ) -> None:
+        """
+        The function initializes `n` scrambled Van der Corput generators.
+
+        :param n: The parameter `n` is the number of dimensions
+
+        :type n: int
+
+        :param base: The `base` parameter holds the bases of the `n` dimensions
+
+        :type base: Sequence[int]
+
+        :param method: The `method` parameter is the scrambling method, see `ScrambledVdCorput`,
+        defaults to "permutation"
+
+        :type method: str (optional)
+
+        :param seed: The `seed` parameter seeds the random scrambling of all dimensions
+
+        :type seed: int (optional)
+        """
+        rng = Random(seed)
+        self.vdcs = [
+            ScrambledVdCorput(base[i], method, rng.getrandbits(64)) for i in range(n)
+        ]
+
+    @classmethod
+    def with_dimension(
+        cls, n: int, method: str = "permutation", seed: Optional[int] = None
+    ) -> "ScrambledHaltonN":
+        """
+        The `with_dimension()` function creates an `n`-dimensional generator whose bases are the
+        first `n` primes, see `lds.primes()`.
+        """
+        return cls(n, primes(n), method, seed)
+
+    def _columns(self, n: int, ks: Optional[range]) -> List[array]:
+        return [vdc._batch(_arguments(vdc, n, ks)) for vdc in self.vdcs]
+
+
+if __name__ == "__main__":
+    import doctest
+
+    doctest.testmod()
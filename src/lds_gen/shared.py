@@ -0,0 +1,331 @@
+"""
+This module contains a shared-memory producer of points for many consumer processes
+
+A `PointProducer` generates the points of one generator, chunk by chunk, into a ring buffer in
+`multiprocessing.shared_memory` from a background thread. Consumers in any number of processes
+claim the next chunk with a shared counter and read its points in place, without copying; a
+slot of the ring is refilled only after the consumer of its chunk has released it. Every chunk
+is handed out exactly once, so that the chunks of all consumers, ordered by their index, form
+the same sequence as successive calls to `pop()` after `reseed(start)`.
+"""
+
+import threading
+import traceback
+from array import array
+from multiprocessing import Condition
+from multiprocessing.shared_memory import SharedMemory
+from typing import Iterator, Optional, Tuple
+
+from .base import layout
+
+# Header of the shared segment: number of chunks produced, number of chunks claimed and the
+# state of the producer, followed by the number of releases of every slot
+_PRODUCED, _CLAIMED, _STATE = range(3)
+_HEADER = 3
+
+_RUNNING, _CLOSED, _FAILED = range(3)
+
+
+class PointConsumer:
+    """Consumer of the chunks of a `PointProducer`
+
+    A consumer holds at most one chunk at a time: `claim()` releases the previous chunk, whose
+    memoryview must not be used afterwards. Consumers are passed to worker processes at their
+    creation, e.g. in the `initargs` of a `ProcessPoolExecutor`.
+    """
+
+    def __init__(
+        self,
+        name: str,
+        cond,
+        dim: int,
+        typecode: str,
+        chunk_size: int,
+        slots: int,
+        start: int,
+        stop: Optional[int],
+    ) -> None:
+        self._name = name
+        self._cond = cond
+        self._dim = dim
+        self._typecode = typecode
+        self._chunk_size = chunk_size
+        self._slots = slots
+        self._start = start
+        self._stop = stop
+        self._shm: Optional[SharedMemory] = None
+        self._view: Optional[memoryview] = None
+        self._held: Optional[int] = None
+
+    def __getstate__(self):
+        state = dict(vars(self))
+        state.update(_shm=None, _view=None, _held=None)
+        return state
+
+    def _header(self) -> memoryview:
+        if self._shm is None:
+            self._shm = SharedMemory(self._name)
+        return self._shm.buf[: 8 * (_HEADER + self._slots)].cast("q")
+
+    def claim(self) -> Optional[Tuple[int, memoryview]]:
+        """
+        The `claim()` function returns the next unclaimed chunk as the index of its first point
+        and a read-only memoryview of its points in row-major order, waiting for the producer if
+        necessary. It returns None at the end of the stream or after the producer was closed.
+        """
+        # the header view is released before any return or raise, so that `close()` can
+        # detach from the shared memory afterwards
+        with self._header() as header, self._cond:
+            self._release(header)
+            chunk = header[_CLAIMED]
+            lo = self._start + chunk * self._chunk_size
+            if self._stop is not None and lo >= self._stop:
+                return None
+            header[_CLAIMED] = chunk + 1
+            while header[_PRODUCED] <= chunk and header[_STATE] == _RUNNING:
+                self._cond.wait()
+            if header[_STATE] == _FAILED:
+                raise RuntimeError("the point producer failed")
+            if header[_STATE] == _CLOSED:
+                return None
+            self._held = chunk
+        n = self._chunk_size
+        if self._stop is not None:
+            n = min(n, self._stop - lo)
+        assert self._shm is not None
+        slot_bytes = _slot_bytes(self._chunk_size, self._dim, self._typecode)
+        begin = _data_offset(self._slots) + (chunk % self._slots) * slot_bytes
+        end = begin + n * self._dim * array(self._typecode).itemsize
+        self._view = self._shm.buf[begin:end].cast(self._typecode).toreadonly()
+        return lo, self._view
+
+    def release(self) -> None:
+        """
+        The `release()` function hands the chunk held by this consumer back to the producer.
+        """
+        with self._header() as header, self._cond:
+            self._release(header)
+
+    def _release(self, header: memoryview) -> None:
+        """Release the held chunk, with the lock held"""
+        if self._held is None:
+            return
+        if self._view is not None:
+            try:
+                self._view.release()
+            except BufferError:  # pragma: no cover
+                pass
+            self._view = None
+        header[_HEADER + self._held % self._slots] += 1
+        self._held = None
+        self._cond.notify_all()
+
+    def close(self) -> None:
+        """
+        The `close()` function releases the held chunk and detaches from the shared memory.
+        """
+        if self._shm is not None:
+            self.release()
+            self._shm.close()
+            self._shm = None
+
+    def __iter__(self) -> Iterator[Tuple[int, memoryview]]:
+        """
+        Iterating over a consumer claims chunks until the end of the stream and releases the
+        last one.
+        """
+        try:
+            while True:
+                chunk = self.claim()
+                if chunk is None:
+                    return
+                yield chunk
+        finally:
+            self.release()
+
+
+class PointProducer:
+    """Shared-memory producer of the points of one generator
+
+    Examples:
+        >>> from lds_gen.lds import HaltonN
+        >>> with PointProducer(HaltonN(2, [2, 3]), chunk_size=2, stop=3) as producer:
+        ...     for index, points in producer.consumer():
+        ...         print(index, points.tolist())
+        ...
+        0 [0.5, 0.3333333333333333, 0.25, 0.6666666666666666]
+        2 [0.75, 0.1111111111111111]
+    """
+
+    chunk_size: int
+    slots: int
+    start: int
+    stop: Optional[int]
+
+    def __init__(
+        self,
+        gen,
+        chunk_size: int = 1024,
+        slots: int = 16,
+        start: int = 0,
+        stop: Optional[int] = None,
+    ) -> None:
+        """
+        The function allocates the ring buffer of `slots` chunks of `chunk_size` points.
+
+        :param gen: The `gen` parameter is a `base.SequenceGenerator`;
+        its state is not changed
+
+        :param chunk_size: The `chunk_size` parameter is the number of points per chunk, defaults
+        to 1024
+
+        :type chunk_size: int (optional)
+
+        :param slots: The `slots` parameter is the number of chunks in the ring buffer, defaults
+        to 16
+
+        :type slots: int (optional)
+
+        :param start: The `start` parameter is the index of the first point, as passed to
+        `reseed()`, defaults to 0
+
+        :type start: int (optional)
+
+        :param stop: The `stop` parameter is the index after the last point, defaults to an
+        endless stream
+
+        :type stop: int (optional)
+        """
+        if chunk_size < 1 or slots < 1:
+            raise ValueError("chunk_size and slots must be positive")
+        if stop is not None and stop < start:
+            raise ValueError("stop must not be less than start")
+        self._gen = gen
+        self._dim, self._typecode = layout(gen)
+        self.chunk_size = chunk_size
+        self.slots = slots
+        self.start = start
+        self.stop = stop
+        slot_bytes = _slot_bytes(chunk_size, self._dim, self._typecode)
+        self._shm = SharedMemory(
+            create=True, size=_data_offset(slots) + slots * slot_bytes
+        )
+        self._cond = Condition()
+        self._thread: Optional[threading.Thread] = None
+        self._error: Optional[BaseException] = None
+
+    @property
+    def name(self) -> str:
+        """The name of the shared memory segment"""
+        return self._shm.name
+
+    def consumer(self) -> PointConsumer:
+        """
+        The `consumer()` function returns a new consumer of the stream.
+        """
+        return PointConsumer(
+            self._shm.name,
+            self._cond,
+            self._dim,
+            self._typecode,
+            self.chunk_size,
+            self.slots,
+            self.start,
+            self.stop,
+        )
+
+    def start_producing(self) -> "PointProducer":
+        """
+        The `start_producing()` function starts the background thread filling the ring buffer.
+        """
+        if self._thread is None:
+            self._thread = threading.Thread(target=self._produce, daemon=True)
+            self._thread.start()
+        return self
+
+    def _produce(self) -> None:
+        header = self._shm.buf[: 8 * (_HEADER + self.slots)].cast("q")
+        data = self._shm.buf[_data_offset(self.slots) :].cast(self._typecode)
+        # the slots are padded to 8 bytes, like the offsets of `PointConsumer.claim()`
+        slot_bytes = _slot_bytes(self.chunk_size, self._dim, self._typecode)
+        stride = slot_bytes // data.itemsize
+        out = data[:0]
+        try:
+            chunk = 0
+            while True:
+                lo = self.start + chunk * self.chunk_size
+                if self.stop is not None and lo >= self.stop:
+                    return
+                slot = chunk % self.slots
+                with self._cond:
+                    # wait until the previous chunk of the slot has been released
+                    while (
+                        header[_STATE] == _RUNNING
+                        and header[_HEADER + slot] < chunk // self.slots
+                    ):
+                        self._cond.wait()
+                    if header[_STATE] != _RUNNING:
+                        return
+                n = self.chunk_size
+                if self.stop is not None:
+                    n = min(n, self.stop - lo)
+                out = data[slot * stride : slot * stride + n * self._dim]
+                self._gen.fill(out, start=lo)
+                with self._cond:
+                    header[_PRODUCED] = chunk + 1
+                    self._cond.notify_all()
+                chunk += 1
+        except BaseException as error:
+            # re-raised by close() in this process, consumers raise RuntimeError
+            # the frames of the traceback must not keep views of the segment alive
+            traceback.clear_frames(error.__traceback__)
+            self._error = error
+            with self._cond:
+                header[_STATE] = _FAILED
+                self._cond.notify_all()
+        finally:
+            out.release()
+            header.release()
+            data.release()
+
+    def close(self) -> None:
+        """
+        The `close()` function stops the producer and frees the shared memory. Consumers waiting
+        for a chunk receive None. An exception raised by the generator is re-raised here.
+        """
+        header = self._shm.buf[: 8 * (_HEADER + self.slots)].cast("q")
+        with self._cond:
+            if header[_STATE] == _RUNNING:
+                header[_STATE] = _CLOSED
+            self._cond.notify_all()
+        header.release()
+        if self._thread is not None:
+            self._thread.join()
+            self._thread = None
+        self._shm.close()
+        self._shm.unlink()
+        if self._error is not None:
+            raise self._error
+
+    def __enter__(self) -> "PointProducer":
+        return self.start_producing()
+
+    def __exit__(self, *exc) -> None:
+        self.close()
+
+
+def _data_offset(slots: int) -> int:
+    """Byte offset of the ring buffer in the shared segment"""
+    return 8 * (_HEADER + slots)
+
+
+def _slot_bytes(chunk_size: int, dim: int, typecode: str) -> int:
+    """Size of one slot of the ring buffer, rounded up to 8 bytes"""
+    size = chunk_size * dim * array(typecode).itemsize
+    return -(-size // 8) * 8
+
+
+if __name__ == "__main__":
+    import doctest
+
+    doctest.testmod()
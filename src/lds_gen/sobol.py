@@ -0,0 +1,183 @@
+"""
+Sobol sequence generator
+
+The points are generated in Gray-code order (Antonov and Saleev): consecutive points differ by
+a single direction number per dimension, so that every step costs one XOR per dimension. The
+direction numbers of Joe and Kuo ("new-joe-kuo-6.21201") are read lazily from a text file in
+their published format, on the first construction of a generator. The file bundled with the
+package holds the first 21 dimensions; the full file with 21201 dimensions can be downloaded
+from https://web.maths.unsw.edu.au/~fkuo/sobol/ and passed as `directions`.
+"""
+
+from array import array
+from functools import reduce
+from itertools import accumulate
+from operator import xor
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+from .lds import _PointBatch
+
+# Number of bits of the coordinates, i.e. at most 2**BITS points
+BITS = 52
+
+_SCALE = 2.0**-BITS
+
+DIRECTIONS_FILE = Path(__file__).with_name("sobol_directions.txt")
+
+# (s, a, m_1 .. m_s) of every dimension from the second on, per file
+_direction_files: Dict[str, List[Tuple[int, int, List[int]]]] = {}
+
+
+def _read_directions(path: str) -> List[Tuple[int, int, List[int]]]:
+    """The rows of a direction number file in the format of Joe and Kuo"""
+    rows = _direction_files.get(path)
+    if rows is None:
+        rows = []
+        with open(path) as file:
+            next(file)  # header: d s a m_i
+            for line in file:
+                if line.strip():
+                    _, s, a, *m = map(int, line.split())
+                    rows.append((s, a, m))
+        _direction_files[path] = rows
+    return rows
+
+
+def direction_numbers(s: int, a: int, m: List[int]) -> List[int]:
+    """
+    The `direction_numbers()` function returns the `BITS` direction numbers of a dimension.
+
+    :param s: The parameter `s` is the degree of the primitive polynomial
+
+    :param a: The parameter `a` holds the inner coefficients of the primitive polynomial
+
+    :param m: The parameter `m` holds the `s` initial direction integers
+
+    Examples:
+        >>> [v >> (BITS - 3) for v in direction_numbers(2, 1, [1, 3])[:3]]
+        [4, 6, 3]
+    """
+    v = [mk << (BITS - k) for k, mk in enumerate(m[:s], 1)]
+    for k in range(s, BITS):
+        vk = v[k - s] ^ (v[k - s] >> s)
+        for i in range(1, s):
+            if (a >> (s - 1 - i)) & 1:
+                vk ^= v[k - i]
+        v.append(vk)
+    return v[:BITS]
+
+
+class Sobol(_PointBatch):
+    """Sobol sequence generator
+
+    Examples:
+        >>> sgen = Sobol(3)
+        >>> sgen.reseed(0)
+        >>> for _ in range(3):
+        ...     print(sgen.pop())
+        ...
+        [0.5, 0.5, 0.5]
+        [0.75, 0.25, 0.25]
+        [0.25, 0.75, 0.75]
+    """
+
+    count: int
+
+    def __init__(self, n: int, directions: Optional[str] = None) -> None:
+        """
+        The function initializes the direction numbers of `n` dimensions.
+
+        :param n: The parameter `n` is the number of dimensions
+
+        :type n: int
+
+        :param directions: The `directions` parameter is the path of a direction number file in the
+        format of Joe and Kuo, defaults to the bundled file with 21 dimensions
+
+        :type directions: str (optional)
+        """
+        rows = _read_directions(str(directions or DIRECTIONS_FILE))
+        if not 1 <= n <= len(rows) + 1:
+            raise ValueError(
+                f"n must be in [1, {len(rows) + 1}] for this direction number file"
+            )
+        # the first dimension is the van der Corput sequence in base 2
+        self._v = [direction_numbers(BITS, 0, [1] * BITS)]
+        self._v += [direction_numbers(*row) for row in rows[: n - 1]]
+        self.reseed(0)
+
+    @property
+    def dim(self) -> int:
+        return len(self._v)
+
+    def _point(self, index: int) -> List[int]:
+        """The integer coordinates of the point with the given index"""
+        gray = index ^ (index >> 1)
+        bits = [j for j in range(gray.bit_length()) if (gray >> j) & 1]
+        return [reduce(xor, [v[j] for j in bits], 0) for v in self._v]
+
+    def pop(self) -> List[float]:
+        """
+        The `pop()` function returns the next point, updating every coordinate by a single XOR.
+
+        Examples:
+            >>> sgen = Sobol(2)
+            >>> sgen.pop()
+            [0.5, 0.5]
+        """
+        # the Gray codes of count and count + 1 differ in the lowest zero bit of count
+        j = (~self.count & (self.count + 1)).bit_length() - 1
+        self.count += 1
+        self._x = [x ^ v[j] for x, v in zip(self._x, self._v)]
+        return [x * _SCALE for x in self._x]
+
+    def _columns(self, n: int, ks: Optional[range]) -> List[array]:
+        if ks is not None and ks.step != 1:
+            points = [self._point(k + 1) for k in ks]
+            return [array("d", [x * _SCALE for x in col]) for col in zip(*points)]
+        if ks is None:
+            start, first = self.count, self._x
+        else:
+            start, first = ks.start, self._point(ks.start)
+        ruler = [(~k & (k + 1)).bit_length() - 1 for k in range(start, start + n)]
+        cols = []
+        last = []
+        for x, v in zip(first, self._v):
+            xs = [x ^ y for y in accumulate(map(v.__getitem__, ruler), xor)]
+            cols.append(array("d", map(_SCALE.__mul__, xs)))
+            last.append(xs[-1] if xs else x)
+        if ks is None:
+            self.count += n
+            self._x = last
+        return cols
+
+    def at(self, index: int) -> List[float]:
+        """
+        The `at()` function returns the point that `pop()` returns right after `reseed(index)`.
+
+        Examples:
+            >>> Sobol(3).at(2)
+            [0.25, 0.75, 0.75]
+        """
+        return [x * _SCALE for x in self._point(index + 1)]
+
+    def reseed(self, seed: int) -> None:
+        """
+        The `reseed` function resets the state of a sequence generator to a specific seed value.
+
+        This is an O(dim * BITS) skip-ahead: after `reseed(i)` the next `pop()` returns `at(i)`.
+
+        :param seed: The `seed` parameter is an integer value that is used to reset the state of the
+        sequence generator. It determines the starting point of the sequence generation
+
+        :type seed: int
+        """
+        self.count = seed
+        self._x = self._point(seed)
+
+
+if __name__ == "__main__":
+    import doctest
+
+    doctest.testmod()
@@ -0,0 +1,236 @@
+"""
+This module contains a low-discrepancy sequence generator on the n-sphere
+
+A point of S^n (in R^(n+1)) is built recursively: the last coordinate is `cos(theta)` for a
+polar angle `theta` in [0, pi] and the remaining ones are a point of S^(n-1) scaled by
+`sin(theta)`, down to S^2, which is covered by `lds.Sphere`. For uniform points the polar
+angle of S^m has the density `sin(theta)**(m-1)` (up to normalization), so every level maps one
+van der Corput value `u` to `theta` by inverting the cumulative distribution.
+
+The inversion uses a table of the cumulative distribution on a uniform grid of [0, pi/2]
+(the distribution is symmetric about pi/2), which is computed once per exponent and shared by
+all generators. A lookup in the table gives a start value that two Newton steps refine to a few
+units of 2**-52. The steps integrate the density from the grid point with Simpson's rule, so
+every value costs a handful of `sin` and `pow` calls, independent of the dimension.
+"""
+
+from array import array
+from bisect import bisect_right
+from itertools import accumulate
+from math import cos, fsum, pi, sin, sqrt
+from operator import mul
+from typing import Dict, List, Optional, Sequence, Tuple
+
+from .lds import Sphere, VdCorput, _arguments, _PointBatch, vdc_batch
+
+try:
+    from . import _native
+except ImportError:  # pragma: no cover
+    _native = None
+
+HALF_PI = pi / 2.0
+
+# Number of grid cells of a polar table on [0, pi/2]
+_POLAR_CELLS = 2048
+
+_NEWTON_STEPS = 2
+
+# Nodes and weights of the 4-point Gauss-Legendre rule on [0, 1]
+_GAUSS_OUTER = 0.5 * sqrt(3.0 / 7.0 + 2.0 / 7.0 * sqrt(6.0 / 5.0))
+_GAUSS_INNER = 0.5 * sqrt(3.0 / 7.0 - 2.0 / 7.0 * sqrt(6.0 / 5.0))
+_GAUSS = [
+    (0.5 - _GAUSS_OUTER, (18.0 - sqrt(30.0)) / 72.0),
+    (0.5 - _GAUSS_INNER, (18.0 + sqrt(30.0)) / 72.0),
+    (0.5 + _GAUSS_INNER, (18.0 + sqrt(30.0)) / 72.0),
+    (0.5 + _GAUSS_OUTER, (18.0 - sqrt(30.0)) / 72.0),
+]
+
+_polar_tables: Dict[int, Tuple[array, array, float]] = {}
+
+
+def polar_table(k: int) -> Tuple[array, array, float]:
+    """
+    The `polar_table()` function returns the inversion table of the polar angle with density
+    `norm * sin(theta)**k` on [0, pi].
+
+    The table is computed on the first call for every `k` and cached.
+
+    :param k: The parameter `k` is the exponent, `m - 1` for the polar angle of S^m
+
+    :type k: int
+
+    :return: The function returns `(cdf, dens, norm)`: the cumulative distribution and the
+    density at the `_POLAR_CELLS + 1` grid points `i * pi / 2 / _POLAR_CELLS`, and the
+    normalization factor `norm`.
+
+    Examples:
+        >>> cdf, dens, norm = polar_table(1)
+        >>> cdf[0], cdf[-1], norm
+        (0.0, 0.5, 0.5)
+    """
+    table = _polar_tables.get(k)
+    if table is None:
+        h = HALF_PI / _POLAR_CELLS
+        masses = [
+            h * fsum(w * sin((i + x) * h) ** k for x, w in _GAUSS)
+            for i in range(_POLAR_CELLS)
+        ]
+        total = 2.0 * fsum(masses)
+        cdf = array("d", [0.0])
+        cdf.extend(m / total for m in accumulate(masses))
+        cdf[-1] = 0.5
+        norm = 1.0 / total
+        dens = array("d", (norm * sin(i * h) ** k for i in range(_POLAR_CELLS + 1)))
+        table = (cdf, dens, norm)
+        _polar_tables[k] = table
+    return table
+
+
+def _polar(
+    u: float, k: int, cdf: array, dens: array, norm: float
+) -> Tuple[float, float]:
+    """sin and cos of the polar angle `theta` with `cdf(theta) == u` (see `polar_table`)"""
+    cells = len(cdf) - 1
+    flip = u > 0.5
+    if flip:
+        u = 1.0 - u
+    h = HALF_PI / cells
+    i = min(bisect_right(cdf, u), cells) - 1
+    lo = i * h
+    if i == 0:
+        # cdf(theta) ~ norm * theta**(k + 1) / (k + 1) near 0
+        theta = ((k + 1) * u / norm) ** (1.0 / (k + 1))
+    else:
+        theta = lo + (u - cdf[i]) / (cdf[i + 1] - cdf[i]) * h
+    for _ in range(_NEWTON_STEPS):
+        d = theta - lo
+        ft = norm * sin(theta) ** k
+        if ft == 0.0:
+            break
+        mass = cdf[i] + d * (dens[i] + 4.0 * norm * sin(lo + 0.5 * d) ** k + ft) / 6.0
+        theta = theta - (mass - u) / ft
+        if theta < lo:
+            theta = lo
+        elif theta > lo + h:
+            theta = lo + h
+    c = cos(theta)
+    return sin(theta), -c if flip else c
+
+
+def _polar_column(args: range, base: int, k: int, scale: array) -> array:
+    """`cos(theta) * scale` for the polar angles of the `vdc()` arguments `args`,
+    multiplying `scale` by `sin(theta)` in place"""
+    cdf, dens, norm = polar_table(k)
+    col = array("d", bytes(8 * len(args)))
+    if _native is not None:
+        try:
+            start, step = args.start, args.step
+            _native.polar_fill(col, scale, cdf, dens, start, step, base, k, norm)
+            return col
+        except OverflowError:
+            pass
+    for i, u in enumerate(vdc_batch(args, base)):
+        s, c = _polar(u, k, cdf, dens, norm)
+        col[i] = c * scale[i]
+        scale[i] *= s
+    return col
+
+
+class SphereN(_PointBatch):
+    """SphereN sequence generator
+
+    The generator covers S^n with `n == len(base)`: the first `n - 2` bases drive the polar
+    angles from S^n down to S^3, the last two the `lds.Sphere` generator of S^2.
+
+    Examples:
+        >>> sgen = SphereN([2, 3, 5, 7])
+        >>> sgen.reseed(0)
+        >>> res = sgen.pop()
+        >>> len(res), round(sum(x * x for x in res), 12)
+        (5, 1.0)
+        >>> sgen.pop_batch(2).tolist() == sgen.slice(1, 3).tolist()
+        True
+    """
+
+    vdcs: List[VdCorput]
+    sphere: Sphere
+
+    def __init__(self, base: Sequence[int], trig: str = "exact") -> None:
+        """
+        The function initializes one `VdCorput` generator per polar angle and the `Sphere`
+        generator of S^2.
+
+        :param base: The `base` parameter holds the `n >= 2` bases of S^n
+
+        :type base: Sequence[int]
+
+        :param trig: The `trig` parameter selects the trigonometric mode of the batch functions
+        of the inner `Sphere`, see `lds.Circle`, defaults to "exact"
+
+        :type trig: str (optional)
+        """
+        n = len(base)
+        if n < 2:
+            raise ValueError("SphereN needs at least two bases")
+        self.vdcs = [VdCorput(b) for b in base[: n - 2]]
+        self.sphere = Sphere(base[n - 2 :], trig)
+        # exponents of the polar densities, from S^n down to S^3
+        self._powers = list(range(n - 1, 1, -1))
+        for k in self._powers:
+            polar_table(k)
+
+    @property
+    def dim(self) -> int:
+        return len(self.vdcs) + 3
+
+    def _point(self, values: List[float], inner: List[float]) -> List[float]:
+        """The point with the polar `vdc()` values `values` and the S^2 point `inner`"""
+        scale = 1.0
+        coords = []
+        for u, k in zip(values, self._powers):
+            s, c = _polar(u, k, *polar_table(k))
+            coords.append(c * scale)
+            scale *= s
+        return [x * scale for x in inner] + coords[::-1]
+
+    def pop(self) -> List[float]:
+        """
+        The `pop()` function returns the next point on S^n as a `List[float]` of `n + 1`
+        coordinates.
+        """
+        return self._point([vdc.pop() for vdc in self.vdcs], self.sphere.pop())
+
+    def _columns(self, n: int, ks: Optional[range]) -> List[array]:
+        scale = array("d", [1.0]) * n
+        coords = [
+            _polar_column(_arguments(vdc, n, ks), vdc.base, k, scale)
+            for vdc, k in zip(self.vdcs, self._powers)
+        ]
+        inner = self.sphere._columns(n, ks)
+        return [array("d", map(mul, col, scale)) for col in inner] + coords[::-1]
+
+    def at(self, index: int) -> List[float]:
+        """
+        The `at()` function returns the point that `pop()` returns right after `reseed(index)`.
+        """
+        values = [vdc.at(index) for vdc in self.vdcs]
+        return self._point(values, self.sphere.at(index))
+
+    def reseed(self, seed: int) -> None:
+        """
+        The `reseed` function resets the state of a sequence generator to a specific seed value.
+
+        :param seed: The `seed` parameter is an integer value that is used to reset the state of the
+        sequence generator. It determines the starting point of the sequence generation
+
+        :type seed: int
+        """
+        for vdc in self.vdcs:
+            vdc.reseed(seed)
+        self.sphere.reseed(seed)
+
+
+if __name__ == "__main__":
+    import doctest
+
+    doctest.testmod()
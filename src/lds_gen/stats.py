@@ -0,0 +1,341 @@
+"""
+This module contains opt-in instrumentation of the sequence generators
+
+`enable()` wraps the methods `pop()`, `pop_batch()`, `slice()` and `fill()` of the generator
+classes (and the functions of `lds_gen.gpu`) with counters, and `disable()` puts the original
+methods back, so that disabled instrumentation costs nothing: the generators run their own code
+without any check. Only the outermost call is recorded, e.g. a `pop_batch()` that calls
+`fill()` counts once, as `pop_batch`.
+
+For every generator class (named by module and class, e.g. "lds.HaltonN") and method the
+counters hold the number of calls per backend ("python", "native" when a compiled kernel ran,
+"gpu"), the number of points produced, the wall time split into the time in the coordinate
+kernels and the rest (output packing, list building and call overhead), the bytes of the
+result arrays allocated, and a histogram of the batch sizes. `snapshot()` returns them as a dict, `prometheus()` in the Prometheus text format.
+
+Examples:
+    >>> from lds_gen.lds import HaltonN
+    >>> reset()
+    >>> with recording():
+    ...     _ = HaltonN(2, [2, 3]).pop_batch(100)
+    >>> metrics = snapshot()["lds.HaltonN"]["pop_batch"]
+    >>> metrics["calls"], metrics["points"], metrics["output_bytes"]
+    (1, 100, 1600)
+    >>> enabled()
+    False
+"""
+
+import functools
+import threading
+from bisect import bisect_left
+from contextlib import contextmanager
+from time import perf_counter
+from typing import Any, Callable, Dict, Iterator, List, Tuple
+
+# Upper bounds of the batch size histogram buckets, followed by +Inf
+BATCH_BUCKETS = (1, 4, 16, 64, 256, 1024, 4096, 16384, 65536, 262144, 1048576)
+
+BACKENDS = ("python", "native", "gpu")
+
+_METHODS = ("pop", "pop_batch", "slice", "fill")
+
+# Methods and functions computing coordinate columns
+_KERNEL_METHODS = ("_columns", "_batch")
+_KERNEL_FUNCTIONS = ("_vdc_range", "vdc_batch")
+
+_lock = threading.Lock()
+_local = threading.local()
+
+# (owner, attribute, original value) of everything replaced by `enable()`
+_patches: List[Tuple[Any, str, Any]] = []
+
+_metrics: Dict[Tuple[str, str], "_Metrics"] = {}
+
+
+class _Metrics:
+    """The counters of one method of one generator class"""
+
+    def __init__(self) -> None:
+        self.calls = dict.fromkeys(BACKENDS, 0)
+        self.points = 0
+        self.seconds = 0.0
+        self.kernel_seconds = 0.0
+        self.output_bytes = 0
+        self.buckets = [0] * (len(BATCH_BUCKETS) + 1)
+
+    def as_dict(self) -> Dict[str, Any]:
+        labels = [str(b) for b in BATCH_BUCKETS] + ["+Inf"]
+        return {
+            "calls": sum(self.calls.values()),
+            "backends": {k: v for k, v in self.calls.items() if v},
+            "points": self.points,
+            "seconds": self.seconds,
+            "kernel_seconds": self.kernel_seconds,
+            "packing_seconds": max(self.seconds - self.kernel_seconds, 0.0),
+            "output_bytes": self.output_bytes,
+            "batch_sizes": dict(zip(labels, self.buckets)),
+        }
+
+
+class _Call:
+    """The state of the outermost instrumented call of the current thread"""
+
+    __slots__ = ("backend", "kernel_seconds", "in_kernel")
+
+    def __init__(self, backend: str) -> None:
+        self.backend = backend
+        self.kernel_seconds = 0.0
+        self.in_kernel = False
+
+
+def _points(method: str, gen, args: tuple, kwargs: dict, res) -> Tuple[int, int]:
+    """The number of points and result bytes of a finished call"""
+    dim = gen.dim
+    if method == "pop":
+        return 1, 0
+    if method == "fill":
+        out = args[0] if args else kwargs["out"]
+        size = getattr(out, "size", None)
+        if size is None:
+            view = memoryview(out)
+            size = view.nbytes // view.itemsize
+        return size // dim, 0
+    if isinstance(res, list):
+        return len(res), 0
+    size = getattr(res, "size", None)
+    if size is None:
+        return len(res) // dim, len(res) * res.itemsize
+    return size // dim, size * res.dtype.itemsize
+
+
+def _record(gen, method: str, call: _Call, seconds: float, points: int, nbytes: int):
+    cls = type(gen)
+    key = (f"{cls.__module__.rsplit('.', 1)[-1]}.{cls.__qualname__}", method)
+    with _lock:
+        metrics = _metrics.get(key)
+        if metrics is None:
+            metrics = _metrics[key] = _Metrics()
+        metrics.calls[call.backend] += 1
+        metrics.points += points
+        metrics.seconds += seconds
+        metrics.kernel_seconds += call.kernel_seconds
+        metrics.output_bytes += nbytes
+        if method != "pop":
+            metrics.buckets[bisect_left(BATCH_BUCKETS, points)] += 1
+
+
+def _api(func: Callable, method: str, backend: str = "python") -> Callable:
+    """`func(gen, ...)` recording its outermost calls"""
+
+    @functools.wraps(func)
+    def wrapper(gen, *args, **kwargs):
+        if getattr(_local, "call", None) is not None:
+            return func(gen, *args, **kwargs)
+        call = _local.call = _Call(backend)
+        begin = perf_counter()
+        try:
+            res = func(gen, *args, **kwargs)
+        finally:
+            _local.call = None
+        seconds = perf_counter() - begin
+        call.kernel_seconds = min(call.kernel_seconds, seconds)
+        if call.backend == "gpu":
+            call.kernel_seconds = seconds
+        points, nbytes = _points(method, gen, args, kwargs, res)
+        _record(gen, method, call, seconds, points, nbytes)
+        return res
+
+    return wrapper
+
+
+def _kernel(func: Callable, native: bool = False) -> Callable:
+    """`func` adding its time to the kernel time of the current call"""
+
+    @functools.wraps(func)
+    def wrapper(*args, **kwargs):
+        call = getattr(_local, "call", None)
+        if call is None:
+            return func(*args, **kwargs)
+        if native:
+            call.backend = "native"
+        if call.in_kernel:
+            return func(*args, **kwargs)
+        call.in_kernel = True
+        begin = perf_counter()
+        try:
+            return func(*args, **kwargs)
+        finally:
+            call.kernel_seconds += perf_counter() - begin
+            call.in_kernel = False
+
+    return wrapper
+
+
+class _NativeProxy:
+    """Stand-in for the compiled extension that marks the calls of its kernels"""
+
+    def __init__(self, native) -> None:
+        self._native = native
+
+    def __getattr__(self, name: str):
+        func = _kernel(getattr(self._native, name), native=True)
+        setattr(self, name, func)
+        return func
+
+
+def _patch(owner, name: str, value) -> None:
+    _patches.append((owner, name, getattr(owner, name)))
+    setattr(owner, name, value)
+
+
+def _modules() -> list:
+    from . import ilds, kronecker, lds, product, scrambled, sobol, sphere_n
+
+    return [lds, ilds, scrambled, sobol, sphere_n, kronecker, product]
+
+
+def enabled() -> bool:
+    """
+    The `enabled()` function tells whether the instrumentation is installed.
+    """
+    return bool(_patches)
+
+
+def enable() -> None:
+    """
+    The `enable()` function installs the instrumentation; it has no effect if it is installed.
+    """
+    if _patches:
+        return
+    from . import gpu, lds
+
+    for module in _modules():
+        for cls in list(vars(module).values()):
+            if not isinstance(cls, type) or cls.__module__ != module.__name__:
+                continue
+            for name in _METHODS:
+                if name in vars(cls):
+                    _patch(cls, name, _api(vars(cls)[name], name))
+            for name in _KERNEL_METHODS:
+                if name in vars(cls):
+                    _patch(cls, name, _kernel(vars(cls)[name]))
+        native = getattr(module, "_native", None)
+        if native is not None:
+            _patch(module, "_native", _NativeProxy(native))
+    for name in _KERNEL_FUNCTIONS:
+        _patch(lds, name, _kernel(getattr(lds, name)))
+    _patch(gpu, "fill", _api(gpu.fill, "fill", "gpu"))
+    _patch(gpu, "generate", _api(gpu.generate, "generate", "gpu"))
+
+
+def disable() -> None:
+    """
+    The `disable()` function removes the instrumentation and restores the original methods. The
+    counters are kept.
+    """
+    while _patches:
+        owner, name, value = _patches.pop()
+        setattr(owner, name, value)
+
+
+@contextmanager
+def recording() -> Iterator[None]:
+    """
+    The `recording()` function returns a context manager that enables the instrumentation for
+    the duration of a `with` block (and leaves it enabled if it already was).
+    """
+    was_enabled = enabled()
+    enable()
+    try:
+        yield
+    finally:
+        if not was_enabled:
+            disable()
+
+
+def reset() -> None:
+    """
+    The `reset()` function clears all counters.
+    """
+    with _lock:
+        _metrics.clear()
+
+
+def snapshot() -> Dict[str, Dict[str, Dict[str, Any]]]:
+    """
+    The `snapshot()` function returns a copy of the counters.
+
+    :return: The function returns `{generator: {method: counters}}`, where `counters` holds
+    "calls", "backends" (the calls per backend), "points", "seconds", "kernel_seconds",
+    "packing_seconds", "output_bytes" and "batch_sizes" (the number of calls per histogram
+    bucket, by upper bound).
+    """
+    res: Dict[str, Dict[str, Dict[str, Any]]] = {}
+    with _lock:
+        for (generator, method), metrics in sorted(_metrics.items()):
+            res.setdefault(generator, {})[method] = metrics.as_dict()
+    return res
+
+
+def prometheus(prefix: str = "lds_gen") -> str:
+    """
+    The `prometheus()` function returns the counters in the Prometheus text exposition format.
+
+    :param prefix: The `prefix` parameter is prepended to the metric names, defaults to "lds_gen"
+
+    :type prefix: str (optional)
+
+    Examples:
+        >>> from lds_gen.lds import Circle
+        >>> reset()
+        >>> with recording():
+        ...     _ = Circle(2).pop()
+        >>> print(prometheus().splitlines()[2])
+        lds_gen_calls_total{generator="lds.Circle",method="pop",backend="python"} 1
+    """
+    data = snapshot()
+    lines: List[str] = []
+
+    def family(name: str, kind: str, help: str) -> str:
+        name = f"{prefix}_{name}"
+        lines.append(f"# HELP {name} {help}")
+        lines.append(f"# TYPE {name} {kind}")
+        return name
+
+    def rows() -> Iterator[Tuple[str, str, Dict[str, Any]]]:
+        for generator, methods in data.items():
+            for method, counters in methods.items():
+                yield method, f'generator="{generator}",method="{method}"', counters
+
+    name = family("calls_total", "counter", "Number of calls, by backend.")
+    for _, labels, counters in rows():
+        for backend, calls in counters["backends"].items():
+            lines.append(f'{name}{{{labels},backend="{backend}"}} {calls}')
+    simple = [
+        ("points_total", "points", "Number of points produced."),
+        ("seconds_total", "seconds", "Wall time of the calls."),
+        ("kernel_seconds_total", "kernel_seconds", "Time spent in coordinate kernels."),
+        ("packing_seconds_total", "packing_seconds", "Time spent outside the kernels."),
+        ("output_bytes_total", "output_bytes", "Bytes of result arrays allocated."),
+    ]
+    for suffix, key, help in simple:
+        name = family(suffix, "counter", help)
+        for _, labels, counters in rows():
+            lines.append(f"{name}{{{labels}}} {counters[key]}")
+    name = family("batch_size", "histogram", "Points per batch call.")
+    for method, labels, counters in rows():
+        if method == "pop":
+            continue
+        total = 0
+        for bound, count in counters["batch_sizes"].items():
+            total += count
+            lines.append(f'{name}_bucket{{{labels},le="{bound}"}} {total}')
+        lines.append(f"{name}_sum{{{labels}}} {counters['points']}")
+        lines.append(f"{name}_count{{{labels}}} {total}")
+    return "\n".join(lines) + "\n"
+
+
+if __name__ == "__main__":
+    import doctest
+
+    doctest.testmod()
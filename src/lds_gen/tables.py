@@ -0,0 +1,127 @@
+"""
+This module contains the cached digit lookup tables used by `vdc` and `vdc_i`
+
+For a base `b` the tables cover the `m` lowest digits of `k` at once, where
+`b**m` is the largest power of the base not exceeding `MAX_ENTRIES`. They are
+built lazily on first use and shared by every generator with that base. Bases
+for which a table would cover fewer than two digits do not get one, and no new
+table is built once `TABLE_BUDGET` bytes are in use.
+"""
+
+from array import array
+from typing import Dict, Optional, Tuple
+
+# Largest number of entries of a single table (16 bits worth of digits)
+MAX_ENTRIES = 2**16
+
+# Upper bound on the memory used by all cached tables, in bytes
+TABLE_BUDGET = 16 * 2**20
+
+_float_tables: Dict[int, Optional[array]] = {}
+_int_tables: Dict[int, Optional[Tuple[array, int]]] = {}
+
+
+def _span(base: int) -> int:
+    """Number of digits `m` covered by the table of `base` (0 if none)"""
+    m = 0
+    while base ** (m + 1) <= MAX_ENTRIES:
+        m += 1
+    return m if m >= 2 else 0
+
+
+def _affordable(nbytes: int) -> bool:
+    return table_memory() + nbytes <= TABLE_BUDGET
+
+
+def float_table(base: int) -> Optional[array]:
+    """Table of `vdc(r, base)` for all `r < base**m`
+
+    The entries are accumulated digit by digit exactly as `vdc` does, so
+    continuing the summation from `table[k % base**m]` with the higher digits
+    of `k` gives a bit-for-bit identical result.
+
+    Examples:
+        >>> float_table(3)[1:4].tolist()
+        [0.3333333333333333, 0.6666666666666666, 0.1111111111111111]
+        >>> float_table(7919) is None
+        True
+    """
+    try:
+        return _float_tables[base]
+    except KeyError:
+        pass
+    m = _span(base)
+    table = None
+    if m != 0 and _affordable(8 * base**m):
+        res = []
+        for r in range(base**m):
+            val = 0.0
+            denom = 1.0
+            while r != 0:
+                denom *= base
+                remainder = r % base
+                r //= base
+                val += remainder / denom
+            res.append(val)
+        table = array("d", res)
+    _float_tables[base] = table
+    return table
+
+
+def int_table(base: int) -> Optional[Tuple[array, int]]:
+    """Table of the `m`-digit reversals of all `r < base**m`, together with `m`
+
+    Entry `r` holds the digits of `r` written in reverse order as an `m`-digit
+    number, i.e. `vdc_i(r, base, m)`.
+
+    Examples:
+        >>> table, m = int_table(3)
+        >>> m
+        10
+        >>> table[1] == 3**9
+        True
+    """
+    try:
+        return _int_tables[base]
+    except KeyError:
+        pass
+    m = _span(base)
+    entry = None
+    if m != 0 and _affordable(2 * base**m):
+        top = base ** (m - 1)
+        table = array("H", [0])
+        for r in range(1, base**m):
+            table.append(table[r // base] // base + (r % base) * top)
+        entry = (table, m)
+    _int_tables[base] = entry
+    return entry
+
+
+def table_memory() -> int:
+    """Number of bytes used by all cached tables
+
+    Examples:
+        >>> _ = float_table(5)
+        >>> table_memory() >= 8 * 5**6
+        True
+    """
+    total = 0
+    for table in _float_tables.values():
+        if table is not None:
+            total += table.itemsize * len(table)
+    for entry in _int_tables.values():
+        if entry is not None:
+            total += entry[0].itemsize * len(entry[0])
+    return total
+
+
+def clear_tables() -> None:
+    """Drop all cached tables"""
+    _float_tables.clear()
+    _int_tables.clear()
+
+
+if __name__ == "__main__":
+    import doctest
+
+    doctest.testmod()
@@ -0,0 +1,102 @@
+import asyncio
+from concurrent.futures import ProcessPoolExecutor
+
+import pytest
+
+from lds_gen import ilds
+from lds_gen.aio import AsyncPoints
+from lds_gen.lds import HaltonN, Sphere, VdCorput
+
+
+class CountingHaltonN(HaltonN):
+    """HaltonN that counts the blocks generated with random access"""
+
+    fills = 0
+
+    def fill(self, out, order="C", start=None):
+        CountingHaltonN.fills += 1
+        super().fill(out, order, start)
+
+
+class FailingHaltonN(HaltonN):
+    def fill(self, out, order="C", start=None):
+        raise RuntimeError("boom")
+
+
+def run(coro):
+    return asyncio.run(coro)
+
+
+def test_iteration_matches_pop():
+    sgen = Sphere([2, 3])
+
+    async def main():
+        res = []
+        async for pt in AsyncPoints(sgen, start=5, stop=25, block_size=7):
+            res.append(pt)
+        return res
+
+    sgen.reseed(5)
+    assert run(main()) == [sgen.pop() for _ in range(20)]
+    vgen = VdCorput(3)
+
+    async def scalars():
+        async with AsyncPoints(vgen, block_size=3) as points:
+            return [await points.__anext__() for _ in range(5)]
+
+    assert run(scalars()) == [vgen.at(i) for i in range(5)]
+
+
+def test_take():
+    hgen = HaltonN(3, [2, 3, 5])
+
+    async def main():
+        async with AsyncPoints(hgen, stop=30, block_size=4) as points:
+            first = await points.take(10)
+            rest = await points.take(100)
+            return first, rest, await points.take(5)
+
+    first, rest, empty = run(main())
+    assert first.shape == (10, 3) and rest.shape == (20, 3) and empty.shape == (0, 3)
+    assert first.tolist() + rest.tolist() == hgen.slice(0, 30).tolist()
+
+
+def test_integer_and_process_executor():
+    hgen = ilds.Halton([2, 3], [11, 7])
+
+    async def main():
+        with ProcessPoolExecutor(2) as pool:
+            async with AsyncPoints(hgen, block_size=16, executor=pool) as points:
+                return await points.take(50)
+
+    res = run(main())
+    assert res.typecode == hgen.typecode
+    assert res.view().tolist() == [hgen.at(i) for i in range(50)]
+
+
+def test_backpressure():
+    CountingHaltonN.fills = 0
+
+    async def main():
+        async with AsyncPoints(
+            CountingHaltonN(2, [2, 3]), block_size=10, prefetch=2
+        ) as points:
+            await points.take(1)
+            for _ in range(20):
+                await asyncio.sleep(0.01)
+            return CountingHaltonN.fills
+
+    # the current block, two queued blocks and one waiting to be queued
+    assert run(main()) <= 4
+
+
+def test_errors():
+    with pytest.raises(ValueError):
+        AsyncPoints(VdCorput(2), prefetch=0)
+
+    async def main():
+        async with AsyncPoints(FailingHaltonN(2, [2, 3])) as points:
+            await points.take(3)
+
+    with pytest.raises(RuntimeError):
+        run(main())
@@ -0,0 +1,55 @@
+from array import array
+
+import pytest
+
+from lds_gen import ilds, lds, scrambled
+from lds_gen.base import SequenceGenerator, layout
+from lds_gen.kronecker import Kronecker
+from lds_gen.product import Product
+from lds_gen.sobol import Sobol
+from lds_gen.sphere_n import SphereN
+
+GENERATORS = [
+    lds.VdCorput(3),
+    lds.IncrementalVdCorput(3),
+    lds.Halton([2, 3]),
+    lds.Circle(2),
+    lds.Sphere([2, 3]),
+    lds.Sphere3Hopf([2, 3, 5]),
+    lds.HaltonN(3, [2, 3, 5]),
+    ilds.VdCorput(3, 7),
+    ilds.IncrementalVdCorput(3, 7),
+    ilds.Halton([2, 3], [11, 7]),
+    scrambled.ScrambledVdCorput(3, seed=1),
+    scrambled.ScrambledHaltonN(2, [2, 3], seed=1),
+    Sobol(3),
+    SphereN([2, 3, 5]),
+    Kronecker(2),
+    Product.auto([(lds.HaltonN, 2), lds.Sphere, lds.VdCorput]),
+]
+
+
+def flat(points):
+    return [x for pt in points for x in (pt if isinstance(pt, list) else [pt])]
+
+
+@pytest.mark.parametrize("gen", GENERATORS)
+def test_protocol(gen):
+    assert isinstance(gen, SequenceGenerator)
+    dim, typecode = layout(gen)
+    gen.reseed(5)
+    first = gen.pop()
+    assert first == gen.at(5)
+    assert len(flat([first])) == dim
+    out = array(typecode, bytes(array(typecode).itemsize * 4 * dim))
+    gen.fill(out, start=5)
+    assert out.tolist() == flat([gen.at(i) for i in range(5, 9)])
+    gen.fill(out)
+    assert out.tolist() == flat([gen.at(i) for i in range(6, 10)])
+
+
+def test_layout():
+    with pytest.raises(TypeError):
+        layout(object())
+    with pytest.raises(OverflowError):
+        layout(ilds.VdCorput(2, 70))
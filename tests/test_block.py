@@ -0,0 +1,155 @@
+import ctypes
+import pickle
+from array import array
+
+import pytest
+
+from lds_gen import block, ilds
+from lds_gen.block import PointBlock
+from lds_gen.lds import HaltonN, VdCorput, vdc, vdc_batch
+
+requires_native = pytest.mark.skipif(
+    block._native is None, reason="the DLPack export needs the compiled extension"
+)
+
+
+class DLTensor(ctypes.Structure):
+    _fields_ = [
+        ("data", ctypes.c_void_p),
+        ("device_type", ctypes.c_int32),
+        ("device_id", ctypes.c_int32),
+        ("ndim", ctypes.c_int32),
+        ("code", ctypes.c_uint8),
+        ("bits", ctypes.c_uint8),
+        ("lanes", ctypes.c_uint16),
+        ("shape", ctypes.POINTER(ctypes.c_int64)),
+        ("strides", ctypes.POINTER(ctypes.c_int64)),
+        ("byte_offset", ctypes.c_uint64),
+    ]
+
+
+class DLManagedTensor(ctypes.Structure):
+    pass
+
+
+DLManagedTensor._fields_ = [
+    ("dl_tensor", DLTensor),
+    ("manager_ctx", ctypes.c_void_p),
+    ("deleter", ctypes.CFUNCTYPE(None, ctypes.POINTER(DLManagedTensor))),
+]
+
+
+def tensor_of(capsule):
+    """The DLManagedTensor of a DLPack capsule"""
+    get_pointer = ctypes.pythonapi.PyCapsule_GetPointer
+    get_pointer.restype = ctypes.c_void_p
+    get_pointer.argtypes = [ctypes.py_object, ctypes.c_char_p]
+    return DLManagedTensor.from_address(get_pointer(capsule, b"dltensor"))
+
+
+def consume(capsule):
+    """Take over the tensor of a capsule as a DLPack consumer does"""
+    managed = tensor_of(capsule)
+    set_name = ctypes.pythonapi.PyCapsule_SetName
+    set_name.argtypes = [ctypes.py_object, ctypes.c_char_p]
+    set_name(capsule, b"used_dltensor")
+    return managed
+
+
+def test_batch_results():
+    hgen = HaltonN(3, [2, 3, 5])
+    res = hgen.pop_batch(4)
+    assert isinstance(res, PointBlock)
+    assert res.shape == (4, 3) and res.order == "C"
+    assert res.view().tolist() == [hgen.at(i) for i in range(4)]
+    res = hgen.slice(0, 4, order="F", dtype="f")
+    assert res.typecode == "f" and res.strides == (1, 4)
+    assert res.view().tolist()[1] == hgen.slice(0, 4, dtype="f").tolist()[1::3]
+    assert VdCorput(3).slice(0, 5).shape == (5,)
+    assert ilds.Halton([2, 3], [11, 7]).pop_batch(3).shape == (3, 2)
+    assert next(hgen.chunks(2)).shape == (2, 3)
+
+
+def test_shape():
+    res = PointBlock("d", (2, 3))
+    assert type(res[1:]) is array
+    res.append(1.0)
+    assert res.shape == (7,)
+    res = pickle.loads(pickle.dumps(HaltonN(2, [2, 3]).pop_batch(3, "F")))
+    assert res.shape == (3, 2) and res.order == "F"
+    with pytest.raises(ValueError):
+        PointBlock("d", (2, 3), "A")
+    assert PointBlock("d", (0, 3)).view().tolist() == []
+
+
+def test_pickle():
+    blocks = [
+        HaltonN(2, [2, 3]).pop_batch(3, "F"),
+        VdCorput(3).slice(0, 4, dtype="f"),
+        ilds.Halton([2, 3], [11, 7]).pop_batch(2),
+        PointBlock("d", (0, 3)),
+    ]
+    for res in blocks:
+        for protocol in range(pickle.HIGHEST_PROTOCOL + 1):
+            copy = pickle.loads(pickle.dumps(res, protocol))
+            assert type(copy) is PointBlock and copy.typecode == res.typecode
+            assert (copy.shape, copy.order) == (res.shape, res.order)
+            assert copy.tolist() == res.tolist()
+
+
+def test_in_place():
+    # the batch functions write into the block allocated by the caller
+    for ks in [range(1, 6), range(2, 30, 3), [7, 1]]:
+        out = PointBlock("d", (len(ks),))
+        assert vdc_batch(ks, 3, out) is out
+        assert out.tolist() == [vdc(k, 3) for k in ks]
+    assert VdCorput(2).slice(1, 9, 3, dtype="f").tolist() == [0.25, 0.625, 0.0625]
+
+
+def test_buffer_shared():
+    res = HaltonN(2, [2, 3]).pop_batch(3)
+    view = memoryview(res)
+    view[0] = 7.0
+    assert res[0] == 7.0
+    with pytest.raises(BufferError):
+        res.append(0.0)
+
+
+@requires_native
+def test_dlpack():
+    res = HaltonN(3, [2, 3, 5]).pop_batch(4, "F")
+    capsule = res.__dlpack__()
+    tensor = tensor_of(capsule).dl_tensor
+    assert tensor.data == res.buffer_info()[0]
+    assert (tensor.device_type, tensor.device_id) == res.__dlpack_device__()
+    assert (tensor.code, tensor.bits, tensor.lanes) == (2, 64, 1)
+    assert tensor.ndim == 2
+    assert [tensor.shape[0], tensor.shape[1]] == [4, 3]
+    assert [tensor.strides[0], tensor.strides[1]] == [1, 4]
+    # the export keeps the block from being resized until the capsule is gone
+    with pytest.raises(BufferError):
+        res.append(0.0)
+    del tensor, capsule
+    res.append(0.0)
+
+
+@requires_native
+def test_dlpack_consumed():
+    res = ilds.VdCorput(3, 7).pop_batch(5)
+    managed = consume(res.__dlpack__())
+    assert (managed.dl_tensor.code, managed.dl_tensor.bits) == (1, 16)
+    assert ctypes.c_uint16.from_address(managed.dl_tensor.data).value == res[0]
+    with pytest.raises(BufferError):
+        res.append(0)
+    managed.deleter(ctypes.pointer(managed))
+    res.append(0)
+
+
+@requires_native
+def test_dlpack_copy():
+    res = HaltonN(2, [2, 3]).pop_batch(2)
+    capsule = res.__dlpack__(copy=True)
+    assert tensor_of(capsule).dl_tensor.data != res.buffer_info()[0]
+    res.append(0.0)
+    with pytest.raises(BufferError):
+        res.__dlpack__(dl_device=(2, 0))
@@ -0,0 +1,96 @@
+import os
+
+import pytest
+
+from lds_gen import ilds
+from lds_gen.cache import PointCache, cache_key
+from lds_gen.lds import HaltonN, Sphere, VdCorput, set_engine
+
+
+def test_get(tmp_path):
+    cache = PointCache(str(tmp_path))
+    for gen in [HaltonN(3, [2, 3, 5]), Sphere([2, 3]), VdCorput(3)]:
+        pts = cache.get(gen, 10, 50)
+        assert pts.readonly
+        assert pts.tolist() == gen.slice(10, 50).tolist()
+        assert cache.get(gen, 20, 30).tolist() == gen.slice(20, 30).tolist()
+
+
+def test_get_ilds(tmp_path):
+    cache = PointCache(str(tmp_path))
+    hgen = ilds.Halton([2, 3], [11, 7])
+    pts = cache.get(hgen, 0, 20)
+    assert pts.format == hgen.typecode
+    assert pts.tolist() == [x for p in hgen.slice(0, 20) for x in p]
+
+
+def test_extend(tmp_path):
+    cache = PointCache(str(tmp_path))
+    hgen = HaltonN(2, [2, 3])
+    cache.get(hgen, 100, 200)
+    inode = os.stat(cache.path(hgen)).st_ino
+    # extending at the end appends in place
+    assert cache.get(hgen, 150, 300).tolist() == hgen.slice(150, 300).tolist()
+    assert os.stat(cache.path(hgen)).st_ino == inode
+    # extending at the front replaces the file, existing mappings stay valid
+    old = cache.get(hgen, 100, 110)
+    assert cache.get(hgen, 0, 400).tolist() == hgen.slice(0, 400).tolist()
+    assert old.tolist() == hgen.slice(100, 110).tolist()
+
+
+def test_parameters(tmp_path):
+    cache = PointCache(str(tmp_path))
+    hgen = HaltonN(2, [2, 3])
+    hgen.reseed(1000)
+    state = hgen.pop()
+    hgen.reseed(1000)
+    assert cache.path(hgen) == cache.path(HaltonN(2, [2, 3]))
+    assert cache.path(hgen) != cache.path(HaltonN(2, [2, 5]))
+    assert cache.get(HaltonN(2, [2, 5]), 0, 5).tolist() == HaltonN(2, [2, 5]).slice(
+        0, 5
+    ).tolist()
+    assert hgen.pop() == state
+
+
+def test_engine(tmp_path):
+    cache = PointCache(str(tmp_path))
+    hgen = HaltonN(3, [2, 3, 5])
+    key = cache_key(hgen)
+    expected = cache.get(hgen, 0, 500).tolist()
+    set_engine("fixed")
+    try:
+        assert cache_key(hgen) != key
+        res = cache.get(hgen, 0, 500).tolist()
+        assert res == hgen.slice(0, 500).tolist()
+        assert res != expected
+    finally:
+        set_engine("float")
+    assert cache_key(hgen) == key
+    assert cache.get(hgen, 0, 500).tolist() == expected
+
+
+def test_corrupted(tmp_path):
+    cache = PointCache(str(tmp_path))
+    hgen = HaltonN(2, [2, 3])
+    cache.get(hgen, 0, 10)
+    with open(cache.path(hgen), "r+b") as file:
+        file.write(b"garbage!")
+    assert cache.get(hgen, 0, 10).tolist() == hgen.slice(0, 10).tolist()
+
+
+def test_workers(tmp_path):
+    cache = PointCache(str(tmp_path))
+    hgen = HaltonN(2, [2, 3])
+    pts = cache.get(hgen, 5, 105, workers=2)
+    assert pts.tolist() == hgen.slice(5, 105).tolist()
+
+
+def test_clear(tmp_path):
+    cache = PointCache(str(tmp_path))
+    hgen = HaltonN(2, [2, 3])
+    cache.get(hgen, 0, 10)
+    cache.clear()
+    assert not os.path.exists(cache.path(hgen))
+    assert cache.get(hgen, 0, 0).tolist() == []
+    with pytest.raises(ValueError):
+        cache.get(hgen, 10, 5)
@@ -0,0 +1,97 @@
+from array import array
+
+import pytest
+
+from lds_gen.cli import GENERATORS, blocks, main, make_generator, npy_header
+from lds_gen.lds import HaltonN, Sphere
+from lds_gen.sphere_n import SphereN
+
+__author__ = "Wai-Shing Luk"
+__copyright__ = "Wai-Shing Luk"
+__license__ = "MIT"
+
+
+def flat(points):
+    return [x for pt in points for x in (pt if isinstance(pt, list) else [pt])]
+
+
+def test_make_generator():
+    fixed = ["vdcorput", "circle", "halton", "sphere", "sphere3hopf"]
+    for name in GENERATORS:
+        gen = make_generator(name, None if name in fixed else 5)
+        assert len(flat([gen.at(0)])) == gen.dim
+    assert make_generator("sobol", 7).dim == 7
+    assert make_generator("spheren", 3).pop() == SphereN([2, 3]).pop()
+    with pytest.raises(ValueError):
+        make_generator("spheren", 2)
+    assert make_generator("haltonn", 2, [3, 7]).pop() == HaltonN(2, [3, 7]).pop()
+    with pytest.raises(ValueError):
+        make_generator("sphere", 4)
+    with pytest.raises(ValueError):
+        make_generator("haltonn")
+    with pytest.raises(ValueError):
+        make_generator("halton", base=[2, 3, 5])
+
+
+def test_blocks():
+    gen = Sphere([2, 3])
+    expected = gen.slice(5, 105).tolist()
+    for threads in [1, 3]:
+        res = blocks(gen, 5, 100, block_size=7, threads=threads)
+        assert [x for block in res for x in block] == expected
+    assert gen.pop() == gen.at(0)
+
+
+def test_binary(tmp_path):
+    path = tmp_path / "points.bin"
+    main(["haltonn", "-d", "3", "-s", "10", "-n", "50", "-o", str(path), "-j", "2"])
+    res = array("d")
+    res.frombytes(path.read_bytes())
+    assert res.tolist() == HaltonN(3, [2, 3, 5]).slice(10, 60).tolist()
+    main(["vdcorput", "-b", "3", "-n", "8", "--float32", "-o", str(path)])
+    assert len(path.read_bytes()) == 4 * 8
+
+
+def test_npy(tmp_path):
+    path = tmp_path / "points.npy"
+    main(["sphere3hopf", "-n", "20", "-f", "npy", "--block-size", "6", "-o", str(path)])
+    data = path.read_bytes()
+    header = npy_header("d", (20, 4))
+    assert data.startswith(header) and len(header) % 64 == 0
+    assert b"'shape': (20, 4)" in header
+    res = array("d")
+    res.frombytes(data[len(header) :])
+    assert res.tolist() == make_generator("sphere3hopf").slice(0, 20).tolist()
+
+
+def test_csv(tmp_path):
+    path = tmp_path / "points.csv"
+    main(["circle", "-b", "3", "-s", "1", "-n", "4", "-f", "csv", "-o", str(path)])
+    rows = path.read_text().splitlines()
+    assert [[float(x) for x in row.split(",")] for row in rows] == [
+        make_generator("circle", base=[3]).at(i) for i in range(1, 5)
+    ]
+
+
+
+def test_csv_float32(tmp_path):
+    path = tmp_path / "points.csv"
+    main(["sphere", "-s", "5", "-n", "50", "-f", "csv", "--float32", "-o", str(path)])
+    values = path.read_text().replace("\n", ",").rstrip(",").split(",")
+    expected = array("f", Sphere([2, 3]).slice(5, 55))
+    assert array("f", [float(x) for x in values]) == expected
+    # the shortest strings: one significant digit less does not round back
+    for x, value in zip(values, expected):
+        digits = len(x.split("e")[0].lstrip("-").replace(".", "").strip("0"))
+        if digits > 1:
+            assert array("f", [float(f"{value:.{digits - 1}g}")])[0] != value
+
+def test_main_errors(capsys):
+    with pytest.raises(SystemExit) as excinfo:
+        main(["spheren", "-n", "10"])
+    assert "spheren needs a valid --dim" in str(excinfo.value)
+    with pytest.raises(SystemExit):
+        main(["halton", "-n", "-1"])
+    with pytest.raises(SystemExit):
+        main(["kronecker", "-d", "2"])
+    assert "--count" in capsys.readouterr().err
@@ -0,0 +1,54 @@
+import math
+
+import pytest
+
+from lds_gen.discrepancy import l2_star, l2_star_sampled
+from lds_gen.kronecker import Kronecker
+from lds_gen.lds import HaltonN, Sphere, VdCorput
+from lds_gen.sobol import Sobol
+
+
+def warnock(points):
+    n, d = len(points), len(points[0])
+    linear = sum(math.prod(1 - x * x for x in p) for p in points)
+    pairs = sum(
+        math.prod(1 - max(x, y) for x, y in zip(p, q)) for p in points for q in points
+    )
+    return math.sqrt(3.0**-d - 2.0 ** (1 - d) / n * linear + pairs / n**2)
+
+
+def test_l2_star_exact():
+    for gen in [HaltonN(3, [2, 3, 5]), Sobol(2), Kronecker(4)]:
+        gen.reseed(10)
+        points = [gen.pop() for _ in range(70)]
+        expected = warnock(points)
+        res = l2_star(gen, 70, start=10, block_size=16, workers=1)
+        assert abs(res - expected) < 1e-12
+        assert l2_star(gen, 70, start=10, block_size=16, workers=2) == res
+        assert gen.pop() == gen.at(80)
+
+
+def test_l2_star_decreases():
+    hgen = HaltonN(2, [2, 3])
+    res = [l2_star(hgen, n, workers=1) for n in [16, 256, 1024]]
+    assert res == sorted(res, reverse=True)
+    assert math.isclose(l2_star(VdCorput(2), 1, start=1, workers=1), math.sqrt(7 / 48))
+
+
+def test_l2_star_sampled():
+    kgen = Kronecker(5)
+    exact = l2_star(kgen, 800, workers=1)
+    kwargs = dict(samples=200, seed=3, block_size=100)
+    est = l2_star_sampled(kgen, 800, workers=1, **kwargs)
+    assert abs(est.value - exact) < 4 * est.stderr
+    assert est == l2_star_sampled(kgen, 800, workers=2, **kwargs)
+    assert est != l2_star_sampled(kgen, 800, samples=200, seed=4, workers=1)
+
+
+def test_errors():
+    with pytest.raises(ValueError):
+        l2_star(Sphere([2, 3]), 10, workers=1)
+    with pytest.raises(ValueError):
+        l2_star(HaltonN(2, [2, 3]), 0)
+    with pytest.raises(ValueError):
+        l2_star_sampled(HaltonN(2, [2, 3]), 10, samples=1)
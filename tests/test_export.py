@@ -0,0 +1,83 @@
+import io
+import json
+
+import pytest
+
+from lds_gen import export
+from lds_gen.ilds import Halton
+from lds_gen.lds import HaltonN, Sphere3Hopf, VdCorput, set_engine
+from lds_gen.sobol import Sobol
+
+
+def flat(points):
+    return [x for pt in points for x in (pt if isinstance(pt, list) else [pt])]
+
+
+def test_metadata():
+    gen = HaltonN(2, [2, 3])
+    meta = export.metadata(gen, 5, 100)
+    assert json.loads(meta["lds_gen.generator"])[0] == "lds_gen.lds.HaltonN"
+    _ = gen.pop()
+    assert export.metadata(gen, 5, 100) == meta
+    other = export.metadata(HaltonN(2, [2, 5]), 5, 100)
+    assert other["lds_gen.key"] != meta["lds_gen.key"]
+    assert meta["lds_gen.engine"] == "float"
+    set_engine("fixed")
+    try:
+        fixed = export.metadata(gen, 5, 100)
+    finally:
+        set_engine("float")
+    assert fixed["lds_gen.engine"] == "fixed"
+    assert fixed["lds_gen.key"] != meta["lds_gen.key"]
+
+
+def test_invalid():
+    with pytest.raises(ValueError):
+        export.write_parquet(VdCorput(2), "points.parquet", 10, points="rows")
+    with pytest.raises(ValueError):
+        export.write_arrow(VdCorput(2), "points.arrow", 10, block_size=0)
+    with pytest.raises(TypeError):
+        next(export.record_batches(object(), 10))
+
+
+@pytest.mark.parametrize(
+    "gen", [VdCorput(3), HaltonN(3, [2, 3, 5]), Halton([2, 3], [11, 7]), Sobol(2)]
+)
+@pytest.mark.parametrize("points", export.LAYOUTS)
+def test_record_batches(gen, points):
+    pytest.importorskip("pyarrow")
+    batches = list(export.record_batches(gen, 10, 5, 4, points))
+    assert [batch.num_rows for batch in batches] == [4, 4, 2]
+    if points == "list":
+        rows = [pt for batch in batches for pt in batch.column(0).to_pylist()]
+    else:
+        columns = [batch.to_pydict().values() for batch in batches]
+        rows = [list(pt) for cols in columns for pt in zip(*cols)]
+    assert flat(rows) == flat([gen.at(i) for i in range(5, 15)])
+
+
+def test_write_parquet():
+    pa = pytest.importorskip("pyarrow")
+    import pyarrow.parquet as pq
+
+    gen = Sphere3Hopf([2, 3, 5])
+    sink = io.BytesIO()
+    export.write_parquet(gen, sink, 1000, start=7, block_size=256, points="columns")
+    table = pq.read_table(pa.BufferReader(sink.getvalue()))
+    assert pq.ParquetFile(pa.BufferReader(sink.getvalue())).num_row_groups == 4
+    assert table.column_names == ["x0", "x1", "x2", "x3"]
+    assert table.schema.metadata[b"lds_gen.start"] == b"7"
+    assert table.slice(3, 1).to_pylist()[0] == dict(zip(table.column_names, gen.at(10)))
+
+
+def test_write_arrow():
+    pa = pytest.importorskip("pyarrow")
+    gen = HaltonN(2, [2, 3])
+    for stream in [False, True]:
+        sink = io.BytesIO()
+        export.write_arrow(gen, sink, 100, block_size=30, stream=stream)
+        source = pa.BufferReader(sink.getvalue())
+        reader = pa.ipc.open_stream(source) if stream else pa.ipc.open_file(source)
+        table = reader.read_all()
+        assert table.num_rows == 100
+        assert table.column(0).to_pylist() == gen.slice(0, 100).view().tolist()
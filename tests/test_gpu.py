@@ -0,0 +1,56 @@
+import pytest
+
+from lds_gen import gpu, lds, scrambled
+
+requires_gpu = pytest.mark.skipif(not gpu.available(), reason="no CUDA device")
+
+
+def test_unsupported():
+    with pytest.raises(TypeError):
+        gpu._plan(scrambled.ScrambledHaltonN(2, [2, 3], seed=1))
+    assert gpu._plan(lds.HaltonN(3, [2, 3, 5])) == ("halton", (2, 3, 5))
+
+
+@requires_gpu
+@pytest.mark.parametrize(
+    "gen",
+    [
+        lds.VdCorput(3),
+        lds.Halton([2, 3]),
+        lds.HaltonN(4, [2, 3, 5, 7]),
+        lds.Circle(3),
+        lds.Sphere([2, 3]),
+        lds.Sphere3Hopf([2, 3, 5]),
+    ],
+)
+def test_generate(gen):
+    for start in [0, 12345, 2**40]:
+        expected = gen.slice(start, start + 1000).tolist()
+        res = gpu.generate(gen, 1000, start).copy_to_host().ravel().tolist()
+        if isinstance(gen, (lds.VdCorput, lds.Halton, lds.HaltonN)):
+            assert res == expected
+        else:
+            assert res == pytest.approx(expected, rel=0, abs=gpu.TOLERANCE)
+
+
+@requires_gpu
+def test_poles():
+    # vdc(3**m, 3) = 3**-(m + 1): cosphi near -1, where sinphi amplifies any error
+    sgen = lds.Sphere([3, 2])
+    for start in [3**9 - 1, 3**20 - 1]:
+        expected = sgen.slice(start, start + 1).tolist()
+        res = gpu.generate(sgen, 1, start).copy_to_host().ravel().tolist()
+        assert res == pytest.approx(expected, rel=0, abs=gpu.TOLERANCE)
+
+@requires_gpu
+def test_float32():
+    from numba import cuda
+
+    sgen = lds.Sphere([2, 3])
+    res = gpu.generate(sgen, 100, dtype="f")
+    assert res.dtype.char == "f"
+    out = cuda.device_array(300, dtype="float64")
+    gpu.fill(sgen, out, start=50)
+    assert out.copy_to_host().tolist() == pytest.approx(
+        sgen.slice(50, 150).tolist(), rel=0, abs=gpu.TOLERANCE
+    )
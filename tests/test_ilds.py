@@ -1,8 +1,15 @@
-from lds_gen.ilds import Halton, VdCorput, vdc_i
+from itertools import islice
+
+import pytest
+
+from lds_gen.ilds import Halton, IncrementalVdCorput, VdCorput, _vdc_i, vdc_i
 
 
 def test_vdc():
     assert vdc_i(1, 2, 10) == 512
+    for base, scale in [(2, 10), (3, 7), (7, 30)]:
+        for k in [0, 1, 12345, base**scale + 3]:
+            assert _vdc_i(k, base, scale, base**scale) == vdc_i(k, base, scale)
 
 
 def test_vdcorput():
@@ -15,3 +22,47 @@ def test_halton():
     hgen = Halton([2, 3], [11, 7])
     hgen.reseed(0)
     assert hgen.pop() == [1024, 729]
+
+
+def test_incremental_vdcorput():
+    igen = IncrementalVdCorput(3, 7)
+    vgen = VdCorput(3, 7)
+    igen.reseed(2000)
+    vgen.reseed(2000)
+    assert [igen.pop() for _ in range(300)] == [vgen.pop() for _ in range(300)]
+
+
+def test_random_access():
+    hgen = Halton([2, 3], [11, 7])
+    hgen.reseed(5)
+    pts = [hgen.pop() for _ in range(10)]
+    assert hgen.at(7) == pts[2]
+    assert hgen.slice(5, 15) == pts
+
+
+def test_iterator_and_chunks():
+    vgen = VdCorput(3, 7)
+    vals = list(islice(vgen, 10))
+    vgen.reseed(0)
+    blocks = vgen.chunks(5)
+    assert list(next(blocks)) == vals[:5]
+    assert list(next(blocks)) == vals[5:]
+
+
+def test_pop_batch_typecode():
+    assert VdCorput(2, 8).typecode == "B"
+    assert VdCorput(3, 10).typecode == "H"
+    assert VdCorput(2, 32).typecode == "I"
+    assert VdCorput(3, 40).typecode == "Q"
+    vgen = VdCorput(3, 10)
+    vals = vgen.slice(0, 50)
+    out = vgen.pop_batch(50)
+    assert out.typecode == "H" and out.tolist() == vals
+    assert vgen.pop() == vgen.at(50)
+    hgen = Halton([2, 3], [8, 20])
+    pts = hgen.slice(0, 10)
+    batch = hgen.pop_batch(10, "F")
+    assert batch.typecode == "I"
+    assert batch.tolist() == [pt[0] for pt in pts] + [pt[1] for pt in pts]
+    with pytest.raises(OverflowError):
+        VdCorput(3, 50).pop_batch(1)
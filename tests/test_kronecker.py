@@ -0,0 +1,50 @@
+from fractions import Fraction
+
+import pytest
+
+from lds_gen.kronecker import BITS, Kronecker, harmonious, rd_alpha
+
+
+def test_alpha():
+    for d in [1, 2, 5]:
+        phi = harmonious(d)
+        assert abs(phi ** (d + 1) - phi - 1) < 1e-25
+        alpha = rd_alpha(d)
+        assert all(0 < a < 2**BITS for a in alpha)
+        assert alpha == sorted(alpha, reverse=True)
+    assert Kronecker(2).alpha == [a / 2**64 for a in rd_alpha(2)]
+
+
+def test_batch_and_skip_ahead():
+    kgen = Kronecker(4)
+    pts = [kgen.pop() for _ in range(300)]
+    flat = [x for pt in pts for x in pt]
+    kgen.reseed(0)
+    assert kgen.pop_batch(100).tolist() == flat[:400]
+    assert kgen.pop() == pts[100]
+    assert kgen.slice(0, 300).tolist() == flat
+    assert kgen.slice(7, 300, 11).tolist() == [x for pt in pts[7::11] for x in pt]
+    assert kgen.slice(299, 6, -3).tolist() == [x for pt in pts[299:6:-3] for x in pt]
+    kgen.reseed(250)
+    assert kgen.pop() == pts[250] == kgen.at(250)
+
+
+def test_no_drift():
+    # 10**10 steps: the fixed-point sum is exact, so k * alpha is reproduced bit for bit
+    kgen = Kronecker(2, alpha=[Fraction(1, 3), 0.25], shift=[0.5, 0.0])
+    k = 10**10
+    kgen.reseed(k - 1)
+    x, y = kgen.pop()
+    assert y == 0.25 * (k % 4)
+    exact = (Fraction(1, 2) + k * Fraction(round(Fraction(2**64, 3)), 2**64)) % 1
+    assert abs(x - float(exact)) < 2**-52
+    assert [x, y] == Kronecker(2, [Fraction(1, 3), 0.25], [0.5, 0.0]).at(k - 1)
+
+
+def test_parameters():
+    assert Kronecker(1, alpha=[1.25]).pop() == [0.25]
+    assert all(0.0 <= x < 1.0 for x in Kronecker(1, alpha=[-(2.0**-60)]).pop())
+    with pytest.raises(ValueError):
+        Kronecker(0)
+    with pytest.raises(ValueError):
+        Kronecker(2, alpha=[0.5])
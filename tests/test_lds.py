@@ -1,6 +1,28 @@
+import math
+import warnings
+from array import array
+from fractions import Fraction
+from itertools import islice
+
+import pytest
 from pytest import approx
 
-from lds_gen.lds import Circle, Halton, HaltonN, Sphere, Sphere3Hopf, VdCorput, vdc
+from lds_gen.lds import (
+    PRIME_TABLE,
+    Circle,
+    Halton,
+    HaltonN,
+    IncrementalVdCorput,
+    Sphere,
+    Sphere3Hopf,
+    VdCorput,
+    get_engine,
+    primes,
+    set_engine,
+    vdc,
+    vdc_batch,
+    vdc_fixed,
+)
 
 
 def test_vdc():
@@ -59,3 +81,250 @@ def test_halton_n():
     res = hgen.pop()
     assert res[0] == 0.25
     assert res[2] == 0.4
+
+
+def test_vdc_batch():
+    assert list(vdc_batch(range(1, 100), 3)) == [vdc(k, 3) for k in range(1, 100)]
+    assert list(vdc_batch([7, 0, 11], 2)) == [vdc(7, 2), 0.0, vdc(11, 2)]
+    assert len(vdc_batch(range(5, 5), 2)) == 0
+
+
+def test_vdcorput_pop_batch():
+    vgen = VdCorput(7)
+    vgen.reseed(1000)
+    res = vgen.pop_batch(500)
+    assert vgen.count == 1500
+    vgen.reseed(1000)
+    assert list(res) == [vgen.pop() for _ in range(500)]
+
+
+def test_halton_pop_batch():
+    hgen = Halton([2, 3])
+    hgen.reseed(10)
+    res = hgen.pop_batch(20)
+    hgen.reseed(10)
+    assert list(res) == [x for _ in range(20) for x in hgen.pop()]
+
+
+def test_halton_n_fill():
+    hgen = HaltonN(4, [2, 3, 5, 7])
+    out = array("d", bytes(8 * 4 * 8))
+    hgen.fill(out, order="F")
+    hgen.reseed(0)
+    pts = [hgen.pop() for _ in range(8)]
+    assert list(out) == [pt[j] for j in range(4) for pt in pts]
+    hgen.reseed(0)
+    assert list(hgen.pop_batch(8)) == [x for pt in pts for x in pt]
+    with pytest.raises(ValueError):
+        hgen.fill(array("d", bytes(8 * 5)))
+    with pytest.raises(TypeError):
+        hgen.fill(array("i", bytes(4 * 8)))
+
+
+def test_incremental_vdcorput():
+    for base in [2, 3, 8]:
+        igen = IncrementalVdCorput(base)
+        vgen = VdCorput(base)
+        igen.reseed(2**40 - 100)
+        vgen.reseed(2**40 - 100)
+        assert [igen.pop() for _ in range(300)] == [vgen.pop() for _ in range(300)]
+        assert list(igen.pop_batch(10)) == list(vgen.pop_batch(10))
+        assert igen.pop() == vgen.pop()
+
+
+@pytest.mark.parametrize(
+    "gen",
+    [
+        VdCorput(3),
+        Halton([2, 3]),
+        Circle(2),
+        Sphere([2, 3]),
+        Sphere3Hopf([2, 3, 5]),
+        HaltonN(4, [2, 3, 5, 7]),
+    ],
+)
+def test_random_access(gen):
+    def flatten(pts):
+        return [x for pt in pts for x in (pt if isinstance(pt, list) else [pt])]
+
+    gen.reseed(37)
+    pts = [gen.pop() for _ in range(20)]
+    assert gen.at(40) == pts[3]
+    assert list(gen.slice(37, 57)) == flatten(pts)
+    assert list(gen.slice(37, 57, 5)) == flatten(pts[::5])
+    gen.reseed(37)
+    assert list(gen.pop_batch(20)) == flatten(pts)
+
+
+def test_iterator_and_chunks():
+    hgen = HaltonN(3, [2, 3, 5])
+    pts = list(islice(hgen, 12))
+    hgen.reseed(0)
+    blocks = hgen.chunks(4)
+    first = next(blocks)
+    assert list(first) == [x for pt in pts[:4] for x in pt]
+    second = next(blocks)
+    assert second is first
+    assert list(second) == [x for pt in pts[4:8] for x in pt]
+    assert next(iter(VdCorput(2))) == 0.5
+
+
+@pytest.mark.parametrize(
+    "make",
+    [
+        lambda trig: Circle(3, trig=trig),
+        lambda trig: Sphere([2, 3], trig=trig),
+        lambda trig: Sphere3Hopf([2, 3, 5], trig=trig),
+    ],
+)
+def test_trig_table(make):
+    for start, stop, step in [(0, 5000, 1), (10**9, 10**9 + 3000, 1), (7, 4000, 13)]:
+        exact = make("exact").slice(start, stop, step)
+        table = make("table").slice(start, stop, step)
+        assert max(abs(x - y) for x, y in zip(exact, table)) < 4e-15
+    gen = make("table")
+    assert gen.pop_batch(10) == make("table").slice(0, 10)
+    with pytest.raises(ValueError):
+        make("fast")
+
+
+def test_primes():
+    limit = 200000
+    flags = [True] * limit
+    for p in range(2, limit):
+        if flags[p]:
+            for q in range(p * p, limit, p):
+                flags[q] = False
+    expected = [p for p in range(2, limit) if flags[p]]
+    assert primes(len(expected)) == expected
+    assert primes(1000) == PRIME_TABLE
+    assert primes(0) == []
+    hgen = HaltonN.with_dimension(1200)
+    assert hgen.dim == 1200
+    assert hgen.vdcs[-1].base == expected[1199]
+
+
+def test_float32():
+    for gen in [
+        HaltonN(3, [2, 3, 5]),
+        Circle(3),
+        Sphere([2, 3]),
+        Sphere3Hopf([2, 3, 5]),
+    ]:
+        expected = array("f", gen.slice(100, 150))
+        res = gen.slice(100, 150, dtype="f")
+        assert res.typecode == "f" and res == expected
+        gen.reseed(100)
+        assert gen.pop_batch(50, dtype="float32") == expected
+        out = array("f", bytes(4 * 50 * gen.dim))
+        gen.fill(out, start=100)
+        assert out == expected
+        assert next(gen.chunks(50, dtype="f")).typecode == "f"
+    vgen = VdCorput(2)
+    assert vgen.slice(0, 2**10, dtype="f").tolist() == vgen.slice(0, 2**10).tolist()
+    out = array("f", bytes(4 * 8))
+    vgen.fill(out)
+    assert out.tolist() == vgen.slice(0, 8).tolist()
+    with pytest.raises(ValueError):
+        vgen.pop_batch(3, dtype="f16")
+
+
+def exact_vdc(k, base):
+    num, den = 0, 1
+    while k:
+        k, r = divmod(k, base)
+        num, den = num * base + r, den * base
+    return Fraction(num, den)
+
+
+def test_vdc_fixed():
+    for base in [2, 3, 7, 1009]:
+        for k in [1, 5, 10**6 + 3, base**12, 2**63 + 5, 2**64 - 1, 2**70 + 3]:
+            ex = exact_vdc(k, base)
+            assert abs(Fraction(vdc_fixed(k, base)) - ex) <= 3 * math.ulp(float(ex))
+    assert [vdc_fixed(k, 2) for k in range(1000)] == [vdc(k, 2) for k in range(1000)]
+    assert vdc_fixed(0, 3) == 0.0
+
+
+def test_fixed_engine():
+    gens = [
+        lambda: IncrementalVdCorput(3),
+        lambda: IncrementalVdCorput(3, leap=5, offset=2),
+        lambda: HaltonN(3, [2, 3, 5]),
+        lambda: Sphere([3, 5]),
+        lambda: Sphere3Hopf([2, 3, 5], trig="table"),
+    ]
+    assert get_engine() == "float"
+    set_engine("fixed")
+    try:
+        assert vdc(7, 3) == vdc_fixed(7, 3)
+        assert vdc_batch(range(1, 100), 3).tolist() == [
+            vdc_fixed(k, 3) for k in range(1, 100)
+        ]
+        for make in gens:
+            gen = make()
+            pts = [gen.pop() for _ in range(40)]
+            assert gen.at(39) == pts[-1]
+            flat = [x for pt in pts for x in (pt if isinstance(pt, list) else [pt])]
+            assert gen.slice(0, 40).tolist() == approx(flat, abs=1e-14)
+    finally:
+        set_engine("float")
+    assert get_engine() == "float"
+    with pytest.raises(ValueError):
+        set_engine("decimal")
+
+
+@pytest.mark.parametrize(
+    "make",
+    [
+        lambda leap, j: VdCorput(3, leap, j),
+        lambda leap, j: IncrementalVdCorput(3, leap, j),
+        lambda leap, j: IncrementalVdCorput(2, leap, j),
+        lambda leap, j: Halton([2, 3], leap, j),
+        lambda leap, j: Circle(5, "exact", leap, j),
+        lambda leap, j: Sphere([2, 3], "exact", leap, j),
+        lambda leap, j: Sphere3Hopf([2, 3, 5], "exact", leap, j),
+        lambda leap, j: HaltonN(3, [2, 3, 5], leap, j),
+    ],
+)
+def test_leap(make):
+    leap, n = 7, 30
+    whole = make(1, 0)
+    pts = [whole.pop() for _ in range(leap * n)]
+    covered = []
+    for j in range(leap):
+        gen = make(leap, j)
+        sub = [gen.pop() for _ in range(n)]
+        assert sub == pts[j::leap]
+        assert [gen.at(i) for i in range(n)] == sub
+        gen.reseed(4)
+        assert gen.pop() == sub[4]
+        assert gen.pop_batch(5).tolist() == gen.slice(5, 10).tolist()
+        assert gen.slice(1, n, 3).tolist() == make(leap, j).slice(1, n, 3).tolist()
+        covered += [leap * i + j for i in range(n)]
+    assert sorted(covered) == list(range(leap * n))
+
+
+def test_leap_digits():
+    gen = IncrementalVdCorput(3, leap=3**7 + 5, offset=11)
+    ref = VdCorput(3, leap=3**7 + 5, offset=11)
+    assert [gen.pop() for _ in range(500)] == ref.pop_batch(500).tolist()
+    gen.reseed(10**6)
+    assert gen.pop() == ref.at(10**6)
+
+
+def test_bad_leap():
+    with pytest.warns(RuntimeWarning):
+        VdCorput(3, leap=6)
+    with pytest.warns(RuntimeWarning):
+        HaltonN(2, [2, 3], leap=9)
+    with warnings.catch_warnings():
+        warnings.simplefilter("error")
+        HaltonN(2, [2, 3], leap=7)
+    with pytest.warns(RuntimeWarning):
+        sub = VdCorput(2, leap=4, offset=1).pop_batch(64).tolist()
+    assert max(sub) - min(sub) < 0.25
+    with pytest.raises(ValueError):
+        VdCorput(2, leap=0)
+    with pytest.raises(ValueError):
+        VdCorput(2, offset=-1)
@@ -0,0 +1,144 @@
+import pytest
+
+from lds_gen import discrepancy, ilds, kronecker, lds, scrambled, sphere_n
+
+_native = pytest.importorskip("lds_gen._native")
+
+
+def vdc_loop(k, base):
+    res = 0.0
+    denom = 1.0
+    while k != 0:
+        denom *= base
+        remainder = k % base
+        k //= base
+        res += remainder / denom
+    return res
+
+
+def vdc_i_loop(k, base, scale):
+    res = 0
+    factor = base**scale
+    while k != 0:
+        factor //= base
+        remainder = k % base
+        k //= base
+        res += remainder * factor
+    return res
+
+
+def pure_python(fn):
+    """Evaluate `fn()` with the compiled batch kernels disabled"""
+    modules = [lds, ilds, scrambled, sphere_n, kronecker, discrepancy]
+    saved = [module._native for module in modules]
+    for module in modules:
+        module._native = None
+    try:
+        return fn()
+    finally:
+        for module, native in zip(modules, saved):
+            module._native = native
+
+
+def test_scalar():
+    ks = [0, 1, 11, 3**20 + 5, 2**53 + 3, 2**64 - 1, 2**64, 2**80 + 7]
+    for base in [2, 3, 7, 1009]:
+        for k in ks:
+            assert _native.vdc(k, base) == vdc_loop(k, base)
+            for scale in [0, 3, 10, 40]:
+                assert _native.vdc_i(k, base, scale) == vdc_i_loop(k, base, scale)
+                res = _native.vdc_i(k, base, scale, base**scale)
+                assert res == vdc_i_loop(k, base, scale)
+    with pytest.raises(ValueError):
+        _native.vdc(-1, 2)
+
+
+@pytest.mark.parametrize(
+    "gen",
+    [
+        lds.HaltonN(3, [2, 3, 5]),
+        lds.Circle(3),
+        lds.Sphere([2, 3]),
+        lds.Sphere3Hopf([2, 3, 5]),
+        lds.Circle(7, trig="table"),
+        lds.Sphere([2, 3], trig="table"),
+        lds.Sphere3Hopf([2, 3, 5], trig="table"),
+        scrambled.ScrambledHaltonN(3, [2, 3, 7919], "permutation", seed=1),
+        scrambled.ScrambledHaltonN(3, [2, 3, 7919], "linear", seed=2),
+        sphere_n.SphereN([2, 3, 5, 7, 11]),
+        kronecker.Kronecker(3),
+    ],
+)
+def test_batch_matches_python(gen):
+    for start in [0, 12345, 2**40]:
+        expected = pure_python(lambda: gen.slice(start, start + 200))
+        assert gen.slice(start, start + 200) == expected
+        assert gen.slice(start, start + 200, 7) == pure_python(
+            lambda: gen.slice(start, start + 200, 7)
+        )
+
+
+
+@pytest.mark.parametrize(
+    "gen",
+    [
+        lds.VdCorput(3),
+        scrambled.ScrambledVdCorput(3, "permutation", seed=1),
+        scrambled.ScrambledVdCorput(3, "linear", seed=2),
+        lds.HaltonN(3, [2, 3, 5]),
+        lds.Sphere([2, 3]),
+    ],
+)
+def test_float32_matches_python(gen):
+    # the kernels round to float32 as they store, like the pure-Python conversion
+    for start in [0, 2**40, 2**64 - 100]:
+        expected = pure_python(lambda: gen.slice(start, start + 200, dtype="f"))
+        assert gen.slice(start, start + 200, dtype="f") == expected
+    with pytest.raises(ValueError):
+        _native.store_fill(lds.array("f", bytes(12)), lds.array("d", [1.0, 2.0]), 2, 1)
+
+def test_ilds_fill():
+    vgen = ilds.VdCorput(3, 11)
+    out = lds.array("I", bytes(4 * 100))
+    vgen.fill(out, start=50)
+    assert out.tolist() == [vdc_i_loop(k, 3, 11) for k in range(51, 151)]
+    with pytest.raises(OverflowError):
+        vgen.fill(lds.array("B", bytes(10)))
+
+
+def test_overflow_falls_back():
+    vgen = lds.VdCorput(3)
+    assert list(vgen.slice(2**64 - 3, 2**64 + 3)) == [
+        vdc_loop(k, 3) for k in range(2**64 - 2, 2**64 + 4)
+    ]
+
+
+def test_warnock_matches_python():
+    hgen = lds.HaltonN(3, [2, 3, 5])
+    res = discrepancy.l2_star(hgen, 50, block_size=8, workers=1)
+    assert res == pure_python(
+        lambda: discrepancy.l2_star(hgen, 50, block_size=8, workers=1)
+    )
+    with pytest.raises(ValueError):
+        _native.warnock_sums(lds.array("d", [0.0]), lds.array("d"), lds.array("d"), 1)
+
+
+@pytest.mark.parametrize(
+    "gen",
+    [
+        lds.HaltonN(3, [2, 3, 7919]),
+        lds.Circle(7),
+        lds.Sphere([2, 3]),
+        lds.Sphere3Hopf([2, 3, 5]),
+        lds.Sphere([2, 3], trig="table"),
+        sphere_n.SphereN([2, 3, 5, 7]),
+    ],
+)
+def test_fixed_engine_matches_python(gen):
+    lds.set_engine("fixed")
+    try:
+        for start in [0, 12345, 2**40, 2**64 - 300]:
+            expected = pure_python(lambda: gen.slice(start, start + 200))
+            assert gen.slice(start, start + 200) == expected
+    finally:
+        lds.set_engine("float")
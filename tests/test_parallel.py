@@ -0,0 +1,30 @@
+from lds_gen import ilds
+from lds_gen.lds import HaltonN, Sphere, Sphere3Hopf, set_engine
+from lds_gen.parallel import generate_parallel
+
+
+def test_generate_parallel():
+    for gen in [HaltonN(4, [2, 3, 5, 7]), Sphere([2, 3]), Sphere3Hopf([2, 3, 5])]:
+        gen.reseed(100)
+        expected = [x for _ in range(50) for x in gen.pop()]
+        for workers in [1, 3]:
+            res = generate_parallel(gen, 50, workers=workers, start=100, chunk_size=7)
+            assert res.tolist() == expected
+
+
+def test_generate_parallel_ilds():
+    hgen = ilds.Halton([2, 3], [11, 7])
+    expected = [x for _ in range(30) for x in hgen.pop()]
+    res = generate_parallel(hgen, 30, workers=2, chunk_size=4)
+    assert res.tolist() == expected
+
+
+def test_generate_parallel_engine():
+    hgen = HaltonN(3, [2, 3, 5])
+    set_engine("fixed")
+    try:
+        expected = hgen.slice(0, 60).tolist()
+        res = generate_parallel(hgen, 60, workers=3, chunk_size=7)
+    finally:
+        set_engine("float")
+    assert res.tolist() == expected
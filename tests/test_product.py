@@ -0,0 +1,53 @@
+import pytest
+
+from lds_gen.kronecker import Kronecker
+from lds_gen.lds import Circle, HaltonN, Sphere, VdCorput
+from lds_gen.product import Product, radical_bases
+from lds_gen.sphere_n import SphereN
+
+
+def test_auto_bases():
+    pgen = Product.auto([(HaltonN, 3), Sphere, Circle, VdCorput, (SphereN, 3)])
+    assert pgen.dim == 3 + 3 + 2 + 1 + 4
+    assert radical_bases(pgen) == [2, 3, 5, 7, 11, 13, 17, 19, 23, 29]
+    assert radical_bases(Product.auto([Circle], skip=2)) == [5]
+    with pytest.raises(TypeError):
+        Product.auto([(Sphere, 2)])
+    with pytest.raises(TypeError):
+        Product.auto([Kronecker])
+
+
+def test_shared_bases_rejected():
+    with pytest.raises(ValueError):
+        Product([HaltonN(2, [2, 3]), Circle(3)])
+    with pytest.raises(ValueError):
+        Product([])
+    with pytest.raises(TypeError):
+        Product([[0.5]])
+
+
+def test_matches_components():
+    parts = [HaltonN(3, [2, 3, 5]), Sphere([7, 11]), VdCorput(13), Kronecker(2)]
+    pgen = Product(parts)
+    pts = [pgen.pop() for _ in range(50)]
+    for gen in parts:
+        gen.reseed(0)
+    expected = []
+    for _ in range(50):
+        pt = []
+        for gen in parts:
+            res = gen.pop()
+            pt += res if isinstance(res, list) else [res]
+        expected.append(pt)
+    assert pts == expected
+    flat = [x for pt in pts for x in pt]
+    pgen.reseed(0)
+    assert pgen.pop_batch(20).tolist() == flat[: 20 * pgen.dim]
+    assert pgen.pop() == pts[20]
+    assert pgen.slice(0, 50).tolist() == flat
+    assert pgen.slice(3, 50, 7).tolist() == [x for pt in pts[3::7] for x in pt]
+    assert pgen.at(30) == pts[30]
+    res = pgen.pop_batch(4, "F")
+    assert res.shape == (4, pgen.dim) and res.view().tolist()[0] == [
+        pt[0] for pt in pts[21:25]
+    ]
@@ -0,0 +1,48 @@
+from array import array
+
+import pytest
+
+from lds_gen.scrambled import SCRAMBLE_METHODS, ScrambledHaltonN, ScrambledVdCorput
+
+
+@pytest.mark.parametrize("method", SCRAMBLE_METHODS)
+def test_scrambled_vdcorput(method):
+    vgen = ScrambledVdCorput(3, method, seed=7)
+    vals = [vgen.pop() for _ in range(100)]
+    assert all(0.0 <= x < 1.0 for x in vals)
+    assert vgen.slice(0, 100).tolist() == vals
+    assert vgen.slice(5, 100, 9).tolist() == vals[5::9]
+    vgen.reseed(0)
+    assert vgen.pop_batch(100).tolist() == vals
+    assert vgen.at(42) == vals[42]
+    assert ScrambledVdCorput(3, method, seed=7).slice(0, 100).tolist() == vals
+    assert ScrambledVdCorput(3, method, seed=8).slice(0, 100).tolist() != vals
+
+
+@pytest.mark.parametrize("method", SCRAMBLE_METHODS)
+def test_stratification(method):
+    # the first base**m points hit every interval of width base**-m once
+    for base, m in [(2, 10), (5, 4), (7919, 1)]:
+        vgen = ScrambledVdCorput(base, method, seed=3)
+        cells = sorted(int(x * base**m) for x in vgen.slice(0, base**m))
+        assert cells == list(range(base**m))
+
+
+def test_digits():
+    vgen = ScrambledVdCorput(2, "shift", seed=5, digits=4)
+    assert vgen.slice(0, 16).tolist() == vgen.slice(16, 32).tolist()
+    with pytest.raises(ValueError):
+        ScrambledVdCorput(2, "owen")
+    with pytest.raises(ValueError):
+        ScrambledVdCorput(2, digits=0)
+
+
+def test_scrambled_halton_n():
+    hgen = ScrambledHaltonN.with_dimension(50, "linear", seed=11)
+    pts = [hgen.pop() for _ in range(20)]
+    flat = [x for pt in pts for x in pt]
+    assert hgen.slice(0, 20).tolist() == flat
+    hgen.reseed(0)
+    assert hgen.pop_batch(20).tolist() == flat
+    assert ScrambledHaltonN.with_dimension(50, "linear", seed=11).at(3) == pts[3]
+    assert hgen.slice(0, 20, dtype="f") == array("f", flat)
@@ -0,0 +1,99 @@
+from concurrent.futures import ProcessPoolExecutor
+
+import pytest
+
+from lds_gen import ilds
+from lds_gen.lds import HaltonN, Sphere3Hopf, VdCorput
+from lds_gen.shared import PointProducer
+
+_consumer = None
+
+
+def _attach(consumer):
+    global _consumer
+    _consumer = consumer
+
+
+def _consume(_):
+    return [(index, points.tolist()) for index, points in _consumer]
+
+
+def test_consumers():
+    gen = Sphere3Hopf([2, 3, 5])
+    with PointProducer(gen, chunk_size=7, slots=3, start=10, stop=110) as producer:
+        with ProcessPoolExecutor(
+            3, initializer=_attach, initargs=(producer.consumer(),)
+        ) as pool:
+            chunks = [c for res in pool.map(_consume, range(3)) for c in res]
+    assert [index for index, _ in sorted(chunks)] == list(range(10, 110, 7))
+    assert [x for _, pts in sorted(chunks) for x in pts] == gen.slice(10, 110).tolist()
+
+
+def test_claim():
+    hgen = ilds.Halton([2, 3], [11, 7])
+    with PointProducer(hgen, chunk_size=4, slots=2, stop=10) as producer:
+        consumer = producer.consumer()
+        index, points = consumer.claim()
+        assert index == 0 and points.readonly and points.format == hgen.typecode
+        assert points.tolist() == [x for p in hgen.slice(0, 4) for x in p]
+        index, points = consumer.claim()
+        assert index == 4
+        last = consumer.claim()
+        assert last[0] == 8 and len(last[1]) == 4
+        assert consumer.claim() is None
+        consumer.close()
+
+
+@pytest.mark.parametrize(
+    "gen, chunk_size, slots",
+    [(ilds.Halton([2, 3], [11, 7]), 1, 4), (ilds.VdCorput(2, 10), 3, 2)],
+)
+def test_padded_slots(gen, chunk_size, slots):
+    # the slots of `chunk_size * dim` values of less than 8 bytes are padded
+    with PointProducer(gen, chunk_size=chunk_size, slots=slots, stop=12) as producer:
+        consumer = producer.consumer()
+        chunks = [points.tolist() for _, points in consumer]
+        consumer.close()
+    expected = gen.slice(0, 12)
+    if gen.dim > 1:
+        expected = [x for p in expected for x in p]
+    assert [x for pts in chunks for x in pts] == expected
+
+
+def test_released():
+    with PointProducer(HaltonN(2, [2, 3]), chunk_size=2, slots=1) as producer:
+        consumer = producer.consumer()
+        _, points = consumer.claim()
+        consumer.release()
+        with pytest.raises(ValueError):
+            points.tolist()
+        consumer.close()
+
+
+def test_close():
+    producer = PointProducer(HaltonN(2, [2, 3]), chunk_size=2, slots=2)
+    producer.start_producing()
+    consumer = producer.consumer()
+    assert consumer.claim()[0] == 0
+    producer.close()
+    assert consumer.claim() is None
+    consumer.close()
+    with pytest.raises(ValueError):
+        PointProducer(HaltonN(2, [2, 3]), chunk_size=0)
+
+
+class _Failing(VdCorput):
+    def fill(self, out, start=None):
+        raise ZeroDivisionError
+
+
+def test_failed():
+    producer = PointProducer(_Failing(), chunk_size=2).start_producing()
+    consumer = producer.consumer()
+    with pytest.raises(RuntimeError) as excinfo:
+        consumer.claim()
+    # the traceback kept by `excinfo` must not keep the header view alive
+    consumer.close()
+    assert "producer failed" in str(excinfo.value)
+    with pytest.raises(ZeroDivisionError):
+        producer.close()
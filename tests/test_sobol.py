@@ -0,0 +1,50 @@
+import pytest
+
+from lds_gen.sobol import BITS, Sobol, direction_numbers
+
+
+def test_sobol_points():
+    sgen = Sobol(3)
+    pts = [sgen.pop() for _ in range(7)]
+    assert pts == [
+        [0.5, 0.5, 0.5],
+        [0.75, 0.25, 0.25],
+        [0.25, 0.75, 0.75],
+        [0.375, 0.375, 0.625],
+        [0.875, 0.875, 0.125],
+        [0.625, 0.125, 0.875],
+        [0.125, 0.625, 0.375],
+    ]
+
+
+def test_stratification():
+    # together with the origin, the first 2**m points are stratified in every dimension
+    m = 10
+    sgen = Sobol(21)
+    pts = [[0.0] * 21] + [sgen.pop() for _ in range(2**m - 1)]
+    for i in range(21):
+        assert sorted(int(pt[i] * 2**m) for pt in pts) == list(range(2**m))
+
+
+def test_batch_and_skip_ahead():
+    sgen = Sobol(5)
+    pts = [sgen.pop() for _ in range(300)]
+    flat = [x for pt in pts for x in pt]
+    sgen.reseed(0)
+    assert sgen.pop_batch(100).tolist() == flat[:500]
+    assert sgen.pop() == pts[100]
+    assert sgen.slice(0, 300).tolist() == flat
+    assert sgen.slice(7, 300, 11).tolist() == [x for pt in pts[7::11] for x in pt]
+    sgen.reseed(250)
+    assert sgen.pop() == pts[250] == sgen.at(250)
+
+
+def test_directions_file(tmp_path):
+    path = tmp_path / "directions.txt"
+    path.write_text("d s a m_i\n2 1 0 1\n")
+    assert Sobol(2, str(path)).slice(0, 3).tolist() == Sobol(2).slice(0, 3).tolist()
+    with pytest.raises(ValueError):
+        Sobol(3, str(path))
+    with pytest.raises(ValueError):
+        Sobol(0)
+    assert len(direction_numbers(3, 1, [1, 3, 1])) == BITS
@@ -0,0 +1,58 @@
+from math import atan2, cos, pi, sin
+
+import pytest
+
+from lds_gen.lds import Sphere
+from lds_gen.sphere_n import SphereN, _polar, polar_table
+
+
+def cdf(k, theta):
+    """Exact cumulative distribution of the density sin(theta)**k on [0, pi]"""
+
+    def integral(k, t):
+        if k == 0:
+            return t
+        if k == 1:
+            return 1.0 - cos(t)
+        return (-cos(t) * sin(t) ** (k - 1) + (k - 1) * integral(k - 2, t)) / k
+
+    return integral(k, theta) / (2.0 * integral(k, pi / 2))
+
+
+def test_polar():
+    for k in [2, 3, 8, 19]:
+        table = polar_table(k)
+        assert polar_table(k) is table
+        for u in [1e-12, 0.001, 0.2, 0.5, 0.7, 0.999]:
+            s, c = _polar(u, k, *table)
+            theta = atan2(s, c)
+            assert abs(cdf(k, theta) - u) < 4e-15
+
+
+def test_sphere_n():
+    sgen = SphereN([2, 3, 5, 7])
+    sgen.reseed(0)
+    points = [sgen.pop() for _ in range(100)]
+    assert all(len(p) == 5 for p in points)
+    assert all(abs(sum(x * x for x in p) - 1.0) < 1e-14 for p in points)
+    assert points[9] == sgen.at(9)
+    flat = [x for p in points for x in p]
+    assert sgen.slice(0, 100).tolist() == flat
+    sgen.reseed(0)
+    assert sgen.pop_batch(100).tolist() == flat
+
+
+def test_moments():
+    sgen = SphereN([2, 3, 5, 7, 11, 13])
+    n = 20000
+    pts = sgen.slice(0, n)
+    for j in range(sgen.dim):
+        col = pts[j :: sgen.dim]
+        assert abs(sum(col) / n) < 0.005
+        assert abs(sum(x * x for x in col) / n * sgen.dim - 1.0) < 0.01
+
+
+def test_sphere2():
+    assert SphereN([2, 3]).slice(0, 10) == Sphere([2, 3]).slice(0, 10)
+    with pytest.raises(ValueError):
+        SphereN([2])
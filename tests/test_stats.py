@@ -0,0 +1,55 @@
+from array import array
+
+from lds_gen import lds, stats
+from lds_gen.lds import Circle, HaltonN, VdCorput
+
+
+def test_disabled_is_untouched():
+    pop_batch = lds._PointBatch.pop_batch
+    native = lds._native
+    with stats.recording():
+        assert stats.enabled()
+        assert lds._PointBatch.pop_batch is not pop_batch
+    assert not stats.enabled()
+    assert lds._PointBatch.pop_batch is pop_batch
+    assert lds._native is native
+    stats.reset()
+    HaltonN(2, [2, 3]).pop_batch(10)
+    assert stats.snapshot() == {}
+
+
+def test_counters():
+    stats.reset()
+    hgen = HaltonN(3, [2, 3, 5])
+    with stats.recording():
+        res = hgen.pop_batch(100)
+        hgen.fill(array("f", bytes(4 * 3 * 5)))
+        VdCorput(3).slice(0, 7)
+        hgen.pop()
+    data = stats.snapshot()
+    batch = data["lds.HaltonN"]["pop_batch"]
+    # the inner fill() of pop_batch() is not counted
+    assert batch["calls"] == 1 and data["lds.HaltonN"]["fill"]["calls"] == 1
+    assert batch["points"] == 100 and batch["output_bytes"] == 8 * len(res)
+    assert batch["batch_sizes"]["256"] == 1 and sum(batch["batch_sizes"].values()) == 1
+    assert 0.0 <= batch["kernel_seconds"] <= batch["seconds"]
+    expected = "native" if lds._native is not None else "python"
+    assert batch["backends"] == {expected: 1}
+    assert data["lds.HaltonN"]["fill"]["points"] == 5
+    assert data["lds.VdCorput"]["slice"]["points"] == 7
+    assert data["lds.HaltonN"]["pop"]["points"] == 1
+    # results are unchanged by the instrumentation
+    assert res == HaltonN(3, [2, 3, 5]).pop_batch(100)
+
+
+def test_prometheus():
+    stats.reset()
+    with stats.recording():
+        Circle(2).pop_batch(3)
+    text = stats.prometheus("qmc")
+    labels = 'generator="lds.Circle",method="pop_batch"'
+    assert f"qmc_points_total{{{labels}}} 3" in text
+    assert f'qmc_batch_size_bucket{{{labels},le="4"}} 1' in text
+    assert f'qmc_batch_size_bucket{{{labels},le="1"}} 0' in text
+    assert f"qmc_batch_size_count{{{labels}}} 1" in text
+    assert "# TYPE qmc_calls_total counter" in text
@@ -0,0 +1,52 @@
+from lds_gen.ilds import vdc_i
+from lds_gen.lds import vdc
+from lds_gen.tables import TABLE_BUDGET, float_table, int_table, table_memory
+
+
+def vdc_loop(k, base):
+    res = 0.0
+    denom = 1.0
+    while k != 0:
+        denom *= base
+        remainder = k % base
+        k //= base
+        res += remainder / denom
+    return res
+
+
+def vdc_i_loop(k, base, scale):
+    res = 0
+    factor = base**scale
+    while k != 0:
+        factor //= base
+        remainder = k % base
+        k //= base
+        res += remainder * factor
+    return res
+
+
+def test_float_table():
+    table = float_table(3)
+    assert len(table) == 3**10
+    assert all(table[k] == vdc_loop(k, 3) for k in range(0, len(table), 97))
+    assert float_table(1009) is None
+
+
+def test_int_table():
+    table, m = int_table(5)
+    assert m == 6
+    assert all(table[k] == vdc_i_loop(k, 5, 6) for k in range(len(table)))
+
+
+def test_table_lookup_is_exact():
+    ks = [0, 1, 12345, 3**10, 3**10 + 1, 2**40 + 7, 2**53 + 1, 3**45 - 1, 2**70 + 5]
+    for base in [2, 3, 4, 7, 11, 257]:
+        for k in ks:
+            assert vdc(k, base) == vdc_loop(k, base)
+            for scale in [1, 5, 10, 13, 50]:
+                assert vdc_i(k, base, scale) == vdc_i_loop(k, base, scale)
+
+
+def test_table_memory():
+    float_table(7)
+    assert 0 < table_memory() <= TABLE_BUDGET